@@ -19,6 +19,10 @@ namespace infini
 
     size_t peak;
 
+    // end of the highest block in use; free blocks above it are returned to
+    // the heap, while peak keeps the high-water mark that getPtr allocates
+    size_t top;
+
     size_t alignment;
 
     // pointer to the memory actually allocated
@@ -51,6 +55,17 @@ namespace infini
 
     void info();
 
+    // function: hand the allocated memory over to the caller, who must free it
+    // with the runtime, and reset the allocator
+    void *detach();
+
+    // function: drop the current plan and release the memory, so that the
+    // allocator can plan again
+    void reset();
+
+    // return: size of the memory block getPtr allocates
+    size_t getPeak() const { return peak; }
+
   private:
     // function: memory alignment, rouned up
     // return: size of the aligned memory block
@@ -0,0 +1,81 @@
+#pragma once
+#include "core/graph.h"
+
+namespace infini
+{
+    class Kernel;
+    class AotModuleObj;
+    using AotModule = Ref<AotModuleObj>;
+
+    /**
+     * @brief A planned graph compiled ahead of time into a shared library.
+     * Every op of the schedule is emitted as C++ loops whose shapes, strides
+     * and arena offsets are compile-time constants, so the host compiler can
+     * fold the indexing and unroll or vectorize the loops, and running the
+     * graph makes no virtual calls. Ops without a generator call back into
+     * their registered kernel.
+     *
+     * The module is tied to the memory plan it was compiled for: it runs on
+     * the graph's arena, and only the buffers outside the arena (bound inputs
+     * and outputs, states) are looked up at every run, so bindData may still
+     * move them. Replanning the graph invalidates the module.
+     */
+    class AotModuleObj
+    {
+    public:
+        // Signature of the entry point of the generated library
+        using EntryFn = void (*)(char *arena, void *const *external,
+                                 void (*fallback)(void *, int), void *self);
+
+    private:
+        Graph graph;
+        OpVec schedule;
+        // Kernels of the ops called back, indexed like schedule
+        vector<Kernel *> fallbacks;
+        // Tensors outside the arena, in the order the generated code expects
+        TensorVec external;
+        void *arenaBase;
+        string workDir;
+        void *handle;
+        EntryFn entry;
+
+        AotModuleObj(const Graph &graph);
+
+        /**
+         * @brief Emits the source of the library and fills the schedule,
+         * fallbacks and external tensors it refers to.
+         */
+        string emit();
+
+        static void callFallback(void *self, int index);
+
+    public:
+        AotModuleObj(AotModuleObj &other) = delete;
+        AotModuleObj &operator=(AotModuleObj const &) = delete;
+        ~AotModuleObj();
+
+        /**
+         * @brief Gets the C++ source generated for a dataMalloc'ed graph.
+         */
+        static string generate(const Graph &graph);
+
+        /**
+         * @brief Generate, build and load the library of a dataMalloc'ed
+         * graph. The compiler is taken from $CXX, defaulting to c++.
+         *
+         * @param flags Flags passed to the compiler besides those building a
+         * shared library.
+         */
+        static AotModule compile(const Graph &graph,
+                                 const string &flags = "-O3 -march=native");
+
+        /**
+         * @brief Run the graph on its current data, like
+         * RuntimeObj::run(graph).
+         */
+        void run() const;
+
+        const string &getWorkDir() const { return workDir; }
+    };
+
+} // namespace infini
@@ -0,0 +1,93 @@
+#pragma once
+#include "core/graph.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace infini
+{
+    /**
+     * @brief Dynamic batching front-end of a graph. Requests are queued and
+     * a worker thread concatenates them along the leading dimension of the
+     * batched inputs, up to maxBatch rows or until the oldest request has
+     * waited maxDelay. The batch is padded up to a power of two rows (or
+     * maxBatch) and run with the plan GraphObj::reshape caches for that
+     * size, and every graph output is split back into per-request results
+     * along its leading dimension.
+     *
+     * The scheduler takes over the graph: it must have been dataMalloc'ed with
+     * its other inputs (e.g. weights) set, and must not be used elsewhere
+     * while the scheduler lives.
+     */
+    class BatchScheduler
+    {
+    public:
+        using Buffer = vector<uint8_t>;
+
+        /**
+         * @param graph The graph to run.
+         * @param batchedInputs Graph inputs whose leading dimension is the
+         * batch dimension.
+         * @param maxBatch Maximum number of rows of a batch.
+         * @param maxDelay How long a request may wait for others to join it.
+         */
+        BatchScheduler(Graph graph, TensorVec batchedInputs, int maxBatch,
+                       std::chrono::microseconds maxDelay);
+        BatchScheduler(BatchScheduler &other) = delete;
+        BatchScheduler &operator=(BatchScheduler const &) = delete;
+        // Runs the requests still queued, then stops the worker.
+        ~BatchScheduler();
+
+        /**
+         * @brief Queue a request.
+         *
+         * @param inputs One buffer per batched input, in order, all holding
+         * the same number of rows.
+         * @return The data of every graph output (in getOutputs() order) for
+         * the rows of this request.
+         */
+        std::future<vector<Buffer>> submit(vector<Buffer> inputs);
+
+        size_t getNumBatches() const { return numBatches; }
+
+    private:
+        struct Request
+        {
+            vector<Buffer> inputs;
+            int rows;
+            std::chrono::steady_clock::time_point arrival;
+            std::promise<vector<Buffer>> result;
+        };
+
+        void work();
+        void runBatch(vector<Request> &batch);
+        // Rows a batch of `rows` is padded to
+        int bucket(int rows) const;
+        // Switch the graph to the plan of a batch of the given rows
+        void reshape(int rows);
+
+        Graph graph;
+        TensorVec batchedInputs;
+        TensorVec outputs;
+        // Per-row bytes of each batched input
+        vector<size_t> rowBytes;
+        // Sorted batch sizes that have a plan
+        vector<int> buckets;
+        const int maxBatch;
+        const std::chrono::microseconds maxDelay;
+        int plannedRows;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Request> queue;
+        int queuedRows;
+        bool stopping;
+        std::atomic<size_t> numBatches;
+        std::thread worker;
+    };
+
+} // namespace infini
@@ -51,6 +51,27 @@ class DataType {
     static constexpr int cpuType[]{-1, 0, 2, 3, 4, 5,  6,  7, -1,
                                    3,  4, 9, 1, 8, -1, -1, 4};
 
+    // Indices of the types above, for use as template arguments
+    struct Index {
+        enum : int {
+            Undefine = 0,
+            Float32 = 1,
+            UInt8 = 2,
+            Int8 = 3,
+            UInt16 = 4,
+            Int16 = 5,
+            Int32 = 6,
+            Int64 = 7,
+            String = 8,
+            Bool = 9,
+            Float16 = 10,
+            Double = 11,
+            UInt32 = 12,
+            UInt64 = 13,
+            BFloat16 = 16,
+        };
+    };
+
   private:
     int index;
 
@@ -60,6 +81,7 @@ class DataType {
     DataType() = default;
     constexpr DataType(int index) : index(index) {}
     bool operator==(const DataType &rhs) const { return index == rhs.index; }
+    bool operator!=(const DataType &rhs) const { return index != rhs.index; }
     bool operator<(const DataType &rhs) const { return index < rhs.index; }
 
     template <typename T> static int get() {
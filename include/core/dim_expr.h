@@ -0,0 +1,45 @@
+#pragma once
+#include "core/common.h"
+
+namespace infini
+{
+    /**
+     * @brief A tensor dimension that is an integer polynomial of named
+     * symbols, e.g. "batch" or 2 * seq + 1. Constants are polynomials of
+     * degree 0 and convert implicitly from int.
+     */
+    class DimExpr
+    {
+    private:
+        // Monomial (sorted symbol names, repeated by degree) -> coefficient.
+        // Terms with a zero coefficient are never stored.
+        map<vector<string>, long long> terms;
+
+    public:
+        DimExpr(int value = 0);
+        explicit DimExpr(const string &symbol);
+
+        bool isConstant() const;
+        optional<int> getConstant() const;
+        set<string> getSymbols() const;
+
+        /**
+         * @brief Evaluate the expression. Every symbol in it must be given.
+         */
+        long long evaluate(const map<string, int> &values) const;
+
+        DimExpr operator+(const DimExpr &rhs) const;
+        DimExpr operator*(const DimExpr &rhs) const;
+        bool operator==(const DimExpr &rhs) const { return terms == rhs.terms; }
+        bool operator!=(const DimExpr &rhs) const { return terms != rhs.terms; }
+        bool operator<(const DimExpr &rhs) const { return terms < rhs.terms; }
+
+        string toString() const;
+    };
+
+    inline DimExpr operator+(int lhs, const DimExpr &rhs) { return rhs + lhs; }
+    inline DimExpr operator*(int lhs, const DimExpr &rhs) { return rhs * lhs; }
+
+    using SymShape = vector<DimExpr>;
+
+} // namespace infini
@@ -0,0 +1,95 @@
+#pragma once
+#include "core/graph.h"
+#include <unordered_map>
+
+namespace infini
+{
+    class ExecutionContextObj;
+    using ExecutionContext = Ref<ExecutionContextObj>;
+
+    /**
+     * @brief Per-invocation state for running a planned graph. The context
+     * owns an activation arena with the layout planned by dataMalloc and the
+     * buffers bound to graph inputs and outputs, so any number of contexts
+     * can run the same graph concurrently, one thread per context. The graph,
+     * its operators and any graph input left unbound (e.g. weights) are
+     * shared and read-only. Graphs with states (GraphObj::addState) are
+     * rejected: a state is appended in place and its length belongs to the
+     * graph, so contexts would race on it.
+     *
+     * While RuntimeObj::run(graph, ctx) executes, TensorObj::getRawDataPtr on
+     * the calling thread resolves to the context's buffers. Kernels must
+     * therefore fetch their pointers before spawning worker threads.
+     */
+    class ExecutionContextObj
+    {
+    private:
+        Graph graph;
+        Runtime runtime;
+        void *arena;
+        // Buffer of every materialized tensor of the graph
+        std::unordered_map<const TensorObj *, char *> ptrs;
+        // Row-slice views created for tile streaming: the tensor they slice
+        // and the byte offset into it
+        std::unordered_map<const TensorObj *, std::pair<const TensorObj *, size_t>>
+            views;
+        vector<void *> owned;
+
+    public:
+        /**
+         * @brief Create a context for a graph that has been dataMalloc'ed.
+         */
+        explicit ExecutionContextObj(Graph graph);
+        ExecutionContextObj(ExecutionContextObj &other) = delete;
+        ExecutionContextObj &operator=(ExecutionContextObj const &) = delete;
+        ~ExecutionContextObj();
+
+        const Graph &getGraph() const { return graph; }
+
+        /**
+         * @brief Bind a caller-owned buffer of at least getBytes() bytes to a
+         * graph input or output.
+         */
+        void bind(const Tensor &tensor, void *ptr);
+
+        /**
+         * @brief Fill a tensor in this context. An unbound graph input gets a
+         * buffer owned by the context, so the shared data stays untouched.
+         */
+        void setData(const Tensor &tensor,
+                     std::function<void(void *, size_t, DataType)> const &generator);
+
+        template <typename T>
+        T getRawDataPtr(const Tensor &tensor) const
+        {
+            static_assert(std::is_pointer_v<T>,
+                          "Raw data pointer has a type of pointer");
+            return reinterpret_cast<T>(resolve(tensor.get()));
+        }
+
+        /**
+         * @brief Buffer of a tensor of the graph or of its schedule.
+         */
+        void *resolve(const TensorObj *tensor) const;
+
+        /**
+         * @brief The context being run on this thread, or nullptr.
+         */
+        static ExecutionContextObj *current();
+
+        /**
+         * @brief Makes a context current on this thread for its lifetime.
+         */
+        class Scope
+        {
+            ExecutionContextObj *previous;
+
+        public:
+            explicit Scope(ExecutionContextObj *ctx);
+            Scope(Scope &other) = delete;
+            Scope &operator=(Scope const &) = delete;
+            ~Scope();
+        };
+    };
+
+} // namespace infini
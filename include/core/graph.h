@@ -1,9 +1,12 @@
 #pragma once
 #include "core/allocator.h"
+#include "core/kernel_tuner.h"
+#include "core/node_arena.h"
 #include "core/operator.h"
 #include "core/tensor.h"
 #include <algorithm>
 #include <cstdint>
+#include <list>
 
 namespace infini
 {
@@ -12,18 +15,90 @@ namespace infini
     {
     protected:
         Runtime runtime;
+        // Storage of the nodes below, shared with every node it holds
+        Ref<NodeArena> arena;
         TensorVec tensors;
         OpVec ops;
         Allocator allocator;
 
     public:
         explicit GraphObj(Runtime runtime)
-            : runtime(runtime), allocator(runtime), sorted(false){};
+            : runtime(runtime), arena(make_ref<NodeArena>()),
+              allocator(runtime), sorted(false),
+              tileBytes(0), symArenaBytes(0), planCapacity(0),
+              activePlan(nullptr){};
         string toString() const override;
         Runtime getRuntime() const { return runtime; }
+        const NodeArena &getArena() const { return *arena; }
 
         Tensor addTensor(Shape dim, DataType dtype = DataType::Float32);
+        /**
+         * @brief Add a tensor whose dims may be symbolic. Its concrete shape,
+         * used while building the graph, takes 1 for every symbol.
+         */
+        Tensor addSymTensor(const SymShape &dim,
+                            DataType dtype = DataType::Float32);
         Tensor addTensor(const Tensor &tensor);
+
+        /**
+         * @brief Enter bulk building mode, for importing large graphs. Ops
+         * added with addOp or addOpWithOutputs are only recorded, and the
+         * outputs addOp creates get placeholder shapes. Shape inference,
+         * checking and wiring are left to a single pass in finalize().
+         */
+        void beginBulkBuild();
+
+        /**
+         * @brief Leave bulk building mode: link and sort the recorded ops,
+         * infer the placeholder output shapes and check the given ones.
+         */
+        void finalize();
+        bool isBulkBuilding() const { return bulkBuilding; }
+
+        /**
+         * @brief Adds an output of an op created while bulk building. Its
+         * shape is inferred by finalize().
+         */
+        Tensor addDeferredTensor(DataType dtype);
+
+        /**
+         * @brief Use a caller-owned buffer as the data of a graph input or
+         * output, without copying. The buffer must hold getBytes() bytes, be
+         * aligned to the element size and stay valid while the graph uses
+         * it. Bound tensors are left out of memory planning and can be
+         * rebound at any time, e.g. once per request. A null ptr unbinds the
+         * tensor, which gets arena memory again at the next dataMalloc.
+         */
+        void bindData(const Tensor &tensor, void *ptr);
+
+        /**
+         * @brief Add a state tensor. Its buffer lives outside the arena and
+         * keeps its contents across runs, e.g. a KV cache. It grows along
+         * `axis` up to `capacity` through an Append op, and all its dims
+         * before `axis` must be 1 so that appending is in place.
+         */
+        Tensor addState(Shape dim, DataType dtype, int axis, int capacity);
+
+        /**
+         * @brief Commit the rows appended by the last run: every state grows
+         * by the input of its Append op and shapes are re-inferred. Memory is
+         * planned for full states, so nothing is replanned.
+         *
+         * @return false if a state has no room left for the rows of the next
+         * run, which is then refused until resetStates().
+         */
+        bool advanceStates();
+        /**
+         * @brief Whether a state has no room left for the rows of one more
+         * run.
+         */
+        bool statesFull() const;
+        bool hasStates() const { return !states.empty(); }
+
+        /**
+         * @brief Shrink every state back to the length it was added with.
+         */
+        void resetStates();
         TensorVec addTensor(const TensorVec &tensors);
         void removeOperator(Operator op)
         {
@@ -55,8 +130,121 @@ namespace infini
 
         void shape_infer();
 
+        /**
+         * @brief Plan and allocate the memory of all tensors. Calling it again,
+         * e.g. after shape_infer, replans from scratch: the data of every
+         * tensor is lost and contexts created for the old plan are invalid.
+         * A Concat whose inputs form contiguous slices of its output and feed
+         * nothing else is elided: the producers write into the slices.
+         */
         void dataMalloc();
 
+        /**
+         * @brief Enable tile-streaming execution. Chains of consecutive ops
+         * that can all be split along the outermost dimension of their outputs
+         * are run tile by tile, so the intermediates of one tile stay in cache
+         * and only need a tile-sized scratch buffer. Takes effect at the next
+         * dataMalloc.
+         *
+         * @param bytes Target working set of one tile, 0 disables streaming.
+         */
+        void setTileStreaming(size_t bytes) { tileBytes = bytes; }
+
+        /**
+         * @brief Let a tuner pick the kernel of every op at each dataMalloc,
+         * among the candidates registered for its dtype. Without a tuner the
+         * first candidate is used.
+         */
+        void setKernelTuner(Tuner tuner) { this->tuner = std::move(tuner); }
+
+        /**
+         * @brief Gets the operators to execute in order. Tile-streamed chains
+         * are expanded into per-tile clones of their ops, and Concats whose
+         * inputs dataMalloc placed in their output are left out.
+         */
+        const OpVec &getSchedule() const
+        {
+            if (activePlan)
+                return activePlan->schedule;
+            return tileStreams.empty() && elidedOps.empty() ? ops : schedule;
+        }
+
+        /**
+         * @brief Keep up to `capacity` memory plans for reshape. Dimensions of
+         * an input that differ from the shape it had when the cache was
+         * enabled are padded up to the smallest of `buckets` that fits, if
+         * any. Call it on a dataMalloc'ed graph.
+         *
+         * Graph inputs move out of the arena into buffers of their own, used
+         * by every plan where they keep that shape. Weights are thus stored
+         * once, and setData on them is seen by all plans.
+         */
+        void setPlanCache(size_t capacity, vector<int> buckets = {});
+
+        /**
+         * @brief Switch the graph inputs, in getInputs() order, to new shapes.
+         * A cached plan for the bucketed shapes is reused as is: tensor
+         * shapes, memory and the kernel parameters of its ops. Otherwise the
+         * shapes are re-inferred, memory is planned and the plan is cached.
+         * Inputs whose shape does not change keep their data. Only the
+         * activations and the resized inputs are stored per plan.
+         *
+         * @return The shapes planned, padded up to the buckets.
+         */
+        vector<Shape> reshape(const vector<Shape> &inputShapes);
+
+        /**
+         * @brief Gets the memory planned by dataMalloc, which every
+         * materialized tensor points into.
+         */
+        void *getArenaBase()
+        {
+            if (activePlan)
+                return activePlan->arena.get();
+            return symArena ? symArena.get() : allocator.getPtr();
+        }
+        size_t getArenaBytes() const
+        {
+            if (activePlan)
+                return activePlan->arenaBytes;
+            return symArena ? symArenaBytes : allocator.getPeak();
+        }
+
+        /**
+         * @brief Infer the symbolic shapes of all tensors and plan memory once
+         * for every value of the symbols. Tensors are assigned to slots by
+         * liveness, a slot being shared only by tensors of the same symbolic
+         * size, so the offsets are sums of slot sizes. Slots of constant size
+         * come first, and graph inputs are never reused, so weights keep
+         * their offset and data across bindSymbols. Tile streaming does not
+         * apply.
+         */
+        void symbolicDataMalloc();
+
+        /**
+         * @brief Instantiate the plan of symbolicDataMalloc for the given
+         * symbol values: evaluate tensor shapes and offsets and refresh the
+         * kernel parameters of the ops. The arena only grows.
+         */
+        void bindSymbols(const map<string, int> &values);
+
+        /**
+         * @brief For a tensor whose memory is a slice of another one, gets the
+         * tensor it slices and the byte offset into it. These are the row
+         * slices created by the tile-streaming schedule and the inputs of
+         * elided Concats.
+         */
+        optional<std::pair<const TensorObj *, size_t>>
+        getTileViewOrigin(const TensorObj *view) const
+        {
+            const auto &origins =
+                activePlan ? activePlan->tileViewOrigins : tileViewOrigins;
+            auto it = origins.find(view);
+            if (it == origins.end())
+                return std::nullopt;
+            return it->second;
+        }
+
         /**
          * @brief Add an operator and create its outputs. Output tensor arguments
          * should be empty Refs (e.g., nullptr).
@@ -64,7 +252,8 @@ namespace infini
         template <typename T, typename... Args>
         Ref<T> addOp(Args &&...args)
         {
-            Ref<T> op = infini::make_ref<T>(this, std::forward<Args>(args)...);
+            Ref<T> op =
+                make_arena_ref<T>(arena, this, std::forward<Args>(args)...);
             addOperatorAndConnect(op);
             return op;
         }
@@ -75,7 +264,9 @@ namespace infini
         template <typename T, typename... Args>
         Ref<T> addOpWithOutputs(Args &&...args)
         {
-            Ref<T> op = infini::make_ref<T>(nullptr, std::forward<Args>(args)...);
+            // While bulk building the op only records its outputs
+            Ref<T> op = make_arena_ref<T>(arena, bulkBuilding ? this : nullptr,
+                                          std::forward<Args>(args)...);
             addOperatorAndConnect(op);
             return op;
         }
@@ -87,19 +278,30 @@ namespace infini
         {
             TensorVec ret;
             for (const auto &t : tensors)
-                if (!t->getSource())
+                if (!t->getSourcePtr())
                     ret.emplace_back(t);
             return ret;
         }
 
+        /**
+         * @brief Mark the tensors the graph is run for. optimize() then
+         * prunes the ops they do not depend on, and dataMalloc keeps only
+         * them alive, freeing other tensors without consumers right after
+         * they are produced. Until outputs are marked, every tensor without
+         * consumers is an output.
+         */
+        void setOutputs(const TensorVec &outputs);
+
         /**
          * @brief Gets output tensors of this graph.
          */
         inline TensorVec getOutputs() const
         {
+            if (!markedOutputs.empty())
+                return markedOutputs;
             TensorVec ret;
             for (const auto &t : tensors)
-                if (t->getTargets().empty())
+                if (t->getNumTargets() == 0)
                     ret.emplace_back(t);
             return ret;
         }
@@ -112,10 +314,156 @@ namespace infini
          */
         void addOperatorAndConnect(const Operator &op);
 
+        /**
+         * @brief Drop tensors no longer used by any op and rebuild the
+         * source/target and predecessor/successor links from ops.
+         */
+        void rebuildConnections();
+
+        /**
+         * @brief Set the source/target and predecessor/successor links of
+         * unlinked ops in one pass.
+         */
+        void connectAll();
+
+        /**
+         * @brief Optimization pass folding dequantize -> MatMul -> quantize
+         * into a QLinearMatMul op.
+         */
+        void fuseQuantizedMatmul();
+
+        /**
+         * @brief Optimization pass removing the ops, without side effects,
+         * that the marked outputs do not depend on.
+         */
+        void eliminateDeadCode();
+
+        bool isOutput(const TensorObj *tensor) const;
+
+        /**
+         * @brief Optimization pass bypassing ops that return their input,
+         * i.e. Clip without bounds, Cast to the same dtype and Transpose with
+         * the identity permutation, dropping Cast pairs that round-trip
+         * losslessly and folding consecutive Transposes into one.
+         */
+        void simplifyAlgebra();
+
+        /**
+         * @brief Optimization pass merging ops of the same type and
+         * attributes on the same inputs, see OperatorObj::getOpAttrVector.
+         */
+        void eliminateCommonSubexpressions();
+
+        /**
+         * @brief Find chains of ops to be executed tile by tile.
+         */
+        void findTileStreams();
+
+        /**
+         * @brief Expand tile-streamed chains into per-tile op clones that read
+         * and write row slices of the materialized tensors.
+         */
+        void buildSchedule();
+
+        /**
+         * @brief Pick the kernel of every op of the schedule from the
+         * registry, or through the tuner if `tune` and one is set. Ops of a
+         * dtype without kernels are left to fail when run.
+         */
+        void selectKernels(bool tune);
+
         /**
          * @brief If the nodes is sorted in topological order.
          */
         bool sorted;
+
+        bool bulkBuilding = false;
+        TensorVec markedOutputs;
+        // Outputs whose shapes finalize() has to infer
+        std::unordered_set<const TensorObj *> deferredTensors;
+
+        struct TileStream
+        {
+            OpVec ops;
+            int rows; // rows of the outermost output dimension per tile
+        };
+
+        size_t tileBytes;
+        Tuner tuner;
+        vector<TileStream> tileStreams;
+        // Concats whose inputs are written in place into their output
+        std::unordered_set<const OperatorObj *> elidedOps;
+        OpVec schedule;
+        std::unordered_map<const TensorObj *, std::pair<const TensorObj *, size_t>>
+            tileViewOrigins;
+
+        struct Plan
+        {
+            vector<Shape> key;    // planned input shapes
+            vector<Shape> shapes; // of every tensor, in `tensors` order
+            vector<Blob> blobs;
+            std::shared_ptr<void> arena;
+            size_t arenaBytes;
+            // Op clones carrying the kernel parameters of this plan
+            OpVec schedule;
+            std::unordered_map<const TensorObj *,
+                               std::pair<const TensorObj *, size_t>>
+                tileViewOrigins;
+        };
+
+        std::unordered_map<const TensorObj *, void *> boundData;
+
+        /**
+         * @brief Point a tensor, and the slices of it in the schedule, at a
+         * buffer.
+         */
+        void setExternalData(const Tensor &tensor, void *ptr);
+
+        struct State
+        {
+            Tensor tensor;
+            int axis;
+            int capacity;
+            int initialLength;
+            std::shared_ptr<void> buffer;
+        };
+        vector<State> states;
+
+        /**
+         * @brief Gets the rows the Append op of a state adds per run.
+         */
+        int appendedRows(const State &state) const;
+
+        // Symbolic memory plan: slot sizes in bytes and the slot of each tensor
+        vector<DimExpr> symSlots;
+        std::unordered_map<const TensorObj *, size_t> symSlotOf;
+        std::shared_ptr<void> symArena;
+        size_t symArenaBytes;
+
+        size_t planCapacity;
+        vector<int> planBuckets;
+        vector<Shape> baseInputShapes;
+        // Graph inputs shared by every plan while they have these dims
+        struct PlanInput
+        {
+            Shape dims;
+            std::shared_ptr<void> buffer;
+        };
+        std::unordered_map<const TensorObj *, PlanInput> planInputs;
+        // Most recently used first
+        std::list<Plan> plans;
+        const Plan *activePlan;
+
+        /**
+         * @brief Move the state left by dataMalloc into a new cached plan and
+         * make it active.
+         */
+        void capturePlan(vector<Shape> key);
+
+        /**
+         * @brief Restore the shapes and memory of a cached plan.
+         */
+        void activatePlan(const Plan &plan);
     };
 
 } // namespace infini
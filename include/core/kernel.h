@@ -21,6 +21,14 @@ namespace infini
          */
         virtual void compute(const Operator &op,
                              const RuntimeObj *context) const = 0;
+
+        /**
+         * @brief Whether the kernel computes the same results as the other
+         * candidates of its key, so that a tuner may pick it for speed. A
+         * reference kept next to an approximation is not, and only runs when
+         * it is the default or is set explicitly.
+         */
+        virtual bool isTunable() const { return true; }
     };
 
     class KernelRegistry
@@ -30,14 +38,17 @@ namespace infini
             tuple<Kernel *const, const string, const int>; // Kernel, name, ID
 
     private:
-        std::map<KernelAttrs, KernelRecord> kernels;
+        // Candidate implementations of each key. The first one registered is
+        // the default, so candidates of a key belong in one source file.
+        std::map<KernelAttrs, vector<KernelRecord>> kernels;
         int nKernels = 0;
 
     public:
         ~KernelRegistry()
         {
-            for (auto &[k, v] : kernels)
-                delete std::get<0>(v);
+            for (auto &[k, records] : kernels)
+                for (auto &record : records)
+                    delete std::get<0>(record);
         }
         static KernelRegistry &getInstance()
         {
@@ -46,22 +57,44 @@ namespace infini
         }
         bool registerKernel(const KernelAttrs &key, Kernel *kernel, string name)
         {
-            IT_ASSERT(kernels.find(key) == kernels.end(),
-                      "Kernel already registered");
-            kernels.emplace(key, KernelRecord{kernel, name, ++nKernels});
+            auto &records = kernels[key];
+            for (auto &record : records)
+                IT_ASSERT(std::get<1>(record) != name,
+                          "Kernel already registered");
+            records.emplace_back(kernel, name, ++nKernels);
             return true;
         }
         Kernel *getKernel(const KernelAttrs &kernelAttrs) const
         {
-            auto it = kernels.find(kernelAttrs);
-            IT_ASSERT(it != kernels.end(), "Kernel not found for key {" +
-                                               get_kernel_attrs_str(kernelAttrs) +
-                                               "}");
-            return std::get<0>(it->second);
+            return std::get<0>(getKernelItem(kernelAttrs));
         }
         const KernelRecord &getKernelItem(const KernelAttrs &kernelAttrs) const
         {
-            return kernels.at(kernelAttrs);
+            return getKernelCandidates(kernelAttrs).front();
+        }
+        const vector<KernelRecord> &
+        getKernelCandidates(const KernelAttrs &kernelAttrs) const
+        {
+            auto records = findKernelCandidates(kernelAttrs);
+            IT_ASSERT(records != nullptr, "Kernel not found for key {" +
+                                              get_kernel_attrs_str(kernelAttrs) +
+                                              "}");
+            return *records;
+        }
+        /**
+         * @brief Gets the kernels registered for the dtype of the key, or else
+         * for any dtype, or nullptr.
+         */
+        const vector<KernelRecord> *
+        findKernelCandidates(const KernelAttrs &kernelAttrs) const
+        {
+            auto it = kernels.find(kernelAttrs);
+            if (it == kernels.end())
+            {
+                auto [device, opType, dtype] = kernelAttrs;
+                it = kernels.find(KernelAttrs{device, opType, DataType::Undefine});
+            }
+            return it == kernels.end() ? nullptr : &it->second;
         }
     };
 
@@ -72,16 +105,72 @@ namespace infini
                              const RuntimeObj *context) const = 0;
     };
 
+    /**
+     * @brief Gets the registry key of an op, typed by its first input.
+     */
+    inline KernelAttrs getKernelAttrs(Device device, const Operator &op)
+    {
+        return KernelAttrs{device, op->getOpType().underlying(), op->getDType()};
+    }
+
+    /**
+     * @brief Registers K<N> for the dtype of index N, for every N.
+     */
+    template <template <int> class K, int... N>
+    bool registerTypedKernels(Device device, OpType::underlying_t opType,
+                              const string &name)
+    {
+        auto &registry = KernelRegistry::getInstance();
+        (registry.registerKernel(KernelAttrs{device, opType, DataType(N)},
+                                 new K<N>(), name),
+         ...);
+        return true;
+    }
+
 } // namespace infini
 
 #define _REGISTER_KERNEL_1(device, opType, kernel, name, cnt)                 \
     namespace infini                                                          \
     {                                                                         \
         static const bool _CAT(_register_kernel_, cnt) =                      \
-            KernelRegistry::getInstance().registerKernel(KernelAttrs{device,  \
-                                                                     opType}, \
-                                                         new kernel(), name); \
+            KernelRegistry::getInstance().registerKernel(                     \
+                KernelAttrs{device, opType, DataType::Undefine}, new kernel(), \
+                name);                                                        \
     }
 
+// Registers a kernel for every dtype, it dispatches on the dtype itself
 #define REGISTER_KERNEL(device, opType, kernel, name) \
     _REGISTER_KERNEL_1(device, opType, kernel, name, __COUNTER__)
+
+#define _REGISTER_TYPED_KERNELS_1(device, opType, kernel, name, cnt, ...)     \
+    namespace infini                                                          \
+    {                                                                         \
+        static const bool _CAT(_register_kernel_, cnt) =                      \
+            registerTypedKernels<kernel, __VA_ARGS__>(device, opType, name);   \
+    }
+
+// Registers kernel<N> under the dtype of index N for each N listed
+#define REGISTER_TYPED_KERNELS(device, opType, kernel, name, ...)              \
+    _REGISTER_TYPED_KERNELS_1(device, opType, kernel, name, __COUNTER__,       \
+                              __VA_ARGS__)
+
+// Dtype lists for REGISTER_TYPED_KERNELS. Arithmetic kernels run on the
+// numeric types, with Float16 and BFloat16 computed in float
+#define CPU_COMPUTE_DTYPES                                                     \
+    ::infini::DataType::Index::Float32, ::infini::DataType::Index::UInt32,     \
+        ::infini::DataType::Index::Int32, ::infini::DataType::Index::Int64,    \
+        ::infini::DataType::Index::Float16, ::infini::DataType::Index::Double, \
+        ::infini::DataType::Index::BFloat16
+// Floating point types only
+#define CPU_FLOAT_DTYPES                                                       \
+    ::infini::DataType::Index::Float32, ::infini::DataType::Index::Float16,    \
+        ::infini::DataType::Index::BFloat16, ::infini::DataType::Index::Double
+// Every fixed-size type, for kernels that only move elements
+#define CPU_COPY_DTYPES                                                        \
+    ::infini::DataType::Index::Float32, ::infini::DataType::Index::UInt8,      \
+        ::infini::DataType::Index::Int8, ::infini::DataType::Index::UInt16,    \
+        ::infini::DataType::Index::Int16, ::infini::DataType::Index::Int32,    \
+        ::infini::DataType::Index::Int64, ::infini::DataType::Index::Bool,     \
+        ::infini::DataType::Index::Float16, ::infini::DataType::Index::Double, \
+        ::infini::DataType::Index::UInt32, ::infini::DataType::Index::UInt64,  \
+        ::infini::DataType::Index::BFloat16
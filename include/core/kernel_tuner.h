@@ -0,0 +1,63 @@
+#pragma once
+#include "core/operator.h"
+#include "core/runtime.h"
+#include <mutex>
+
+namespace infini
+{
+    class KernelTuner;
+    using Tuner = Ref<KernelTuner>;
+
+    /**
+     * @brief Picks the fastest of the kernels registered for an op by timing
+     * them on the op's shapes, with zero-filled scratch copies of its tensors.
+     * Results are keyed by the op signature (type, attributes, dtypes and
+     * shapes), so ops of the same signature are timed once, and can be
+     * persisted in a cache file to skip timing in later processes. Attach a
+     * tuner with GraphObj::setKernelTuner to tune every dataMalloc.
+     */
+    class KernelTuner
+    {
+    private:
+        string cacheFile;
+        int repeats;
+        // Op signature -> name of the winning kernel
+        std::map<string, string> winners;
+        std::mutex mutex;
+
+    public:
+        /**
+         * @param cacheFile File the results are loaded from and saved to, ""
+         * keeps them in memory.
+         * @param repeats Timed runs per candidate, the fastest one counts.
+         */
+        explicit KernelTuner(string cacheFile = "", int repeats = 3);
+
+        /**
+         * @brief Pick the kernel of every op of the graph's schedule. The
+         * candidates are timed on zero-filled scratch copies of the tensors
+         * of an op, so its data is left untouched.
+         */
+        void tune(GraphObj &graph);
+
+        /**
+         * @brief Gets the kernel recorded for an op, timing the candidates
+         * first if its signature is new. nullptr if none is registered.
+         */
+        Kernel *select(const Operator &op, const RuntimeObj *runtime);
+
+        /**
+         * @brief Write the recorded results to the cache file.
+         */
+        void save();
+
+        static string signature(const Operator &op, Device device);
+
+    private:
+        // `timed` tells whether the candidates were timed and a new result
+        // recorded
+        Kernel *select(const Operator &op, const RuntimeObj *runtime,
+                       bool &timed);
+    };
+
+} // namespace infini
@@ -0,0 +1,74 @@
+#pragma once
+#include "core/ref.h"
+#include <cstddef>
+#include <memory_resource>
+
+namespace infini {
+
+/**
+ * @brief Bump allocator the tensors and ops of a graph are carved from, so
+ * that nodes built together sit next to each other in a few large blocks.
+ * Freeing a node is a no-op; the blocks are released at once when the graph
+ * and the last Ref to any of its nodes are gone. Not thread-safe: nodes of
+ * one graph must be created from one thread at a time.
+ */
+class NodeArena {
+    std::pmr::monotonic_buffer_resource resource;
+    size_t allocated = 0;
+
+  public:
+    explicit NodeArena(size_t initialBytes = 64 << 10)
+        : resource(initialBytes) {}
+    NodeArena(const NodeArena &) = delete;
+    NodeArena &operator=(const NodeArena &) = delete;
+
+    void *allocate(size_t bytes, size_t alignment) {
+        allocated += bytes;
+        return resource.allocate(bytes, alignment);
+    }
+    // Bytes handed out so far, including those of nodes already freed
+    size_t getAllocatedBytes() const { return allocated; }
+};
+
+/**
+ * @brief Allocator for std::allocate_shared. Every copy, including the one
+ * kept in a node's control block, shares ownership of the arena, so nodes
+ * may outlive the graph that created them.
+ */
+template <typename T> class ArenaAllocator {
+    template <typename U> friend class ArenaAllocator;
+    Ref<NodeArena> arena;
+
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Ref<NodeArena> arena) : arena(std::move(arena)) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T *, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+        return arena == other.arena;
+    }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const {
+        return arena != other.arena;
+    }
+};
+
+/**
+ * @brief make_ref with the object and its reference counts placed in an arena.
+ */
+template <typename T, typename... Params>
+Ref<T> make_arena_ref(const Ref<NodeArena> &arena, Params &&...params) {
+    static_assert(is_ref<T>::value == false, "Ref should not be nested");
+    return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                   std::forward<Params>(params)...);
+}
+
+} // namespace infini
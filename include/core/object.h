@@ -1,6 +1,7 @@
 #pragma once
 #include "core/common.h"
 #include "ref.h"
+#include <atomic>
 
 namespace infini {
 
@@ -17,12 +18,26 @@ class Uid {
     operator UidBaseType() const { return uid; }
 };
 
+/**
+ * @brief Gets the next id of the sequence named by Tag. Each thread reserves
+ * blocks of ids from a shared atomic counter and hands them out without
+ * synchronization, so objects can be created from several threads. Ids are
+ * consecutive within a thread, but not across threads.
+ */
+template <typename Tag> UidBaseType generateUid() {
+    constexpr UidBaseType blockSize = 1024;
+    static std::atomic<UidBaseType> reserved{0};
+    thread_local UidBaseType next = 0, end = 0;
+    if (next == end) {
+        next = reserved.fetch_add(blockSize, std::memory_order_relaxed) + 1;
+        end = next + blockSize;
+    }
+    return next++;
+}
+
 class Guid : public Uid {
   private:
-    UidBaseType generateGuid() {
-        static UidBaseType guidCnt = 0;
-        return ++guidCnt;
-    }
+    UidBaseType generateGuid() { return generateUid<Guid>(); }
 
   public:
     Guid() : Uid(generateGuid()) {}
@@ -34,10 +49,7 @@ class Guid : public Uid {
  */
 class Fuid : public Uid {
   private:
-    UidBaseType generateFuid() {
-        static UidBaseType fuidCnt = 0;
-        return ++fuidCnt;
-    }
+    UidBaseType generateFuid() { return generateUid<Fuid>(); }
 
   public:
     Fuid() : Uid(generateFuid()) {}
@@ -24,6 +24,16 @@ namespace infini
             Relu,
             Sub,
             Transpose,
+            QuantizeLinear,
+            DequantizeLinear,
+            QLinearMatMul,
+            MatMulNBits,
+            Append,
+            Gelu,
+            Silu,
+            Sigmoid,
+            Tanh,
+            Exp,
 
         } type;
 
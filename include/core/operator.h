@@ -5,10 +5,13 @@
 
 namespace infini
 {
-    using KernelAttrs = std::tuple<Device, OpType::underlying_t>;
+    // DataType::Undefine stands for kernels registered for every dtype
+    using KernelAttrs = std::tuple<Device, OpType::underlying_t, DataType>;
 
     class GraphObj;
-    class OperatorObj : public Object
+    class Kernel;
+    class OperatorObj : public Object,
+                        public std::enable_shared_from_this<OperatorObj>
     {
         friend class GraphObj;
 
@@ -16,11 +19,15 @@ namespace infini
         OpType type;
         TensorVec inputs;
         TensorVec outputs;
-        vector<WRef<OperatorObj>> predecessors;
-        vector<WRef<OperatorObj>> successors;
+        // Non-owning, an op unlinks itself from its neighbours when destroyed
+        vector<OperatorObj *> predecessors;
+        vector<OperatorObj *> successors;
+        // Implementation picked by the kernel tuner, nullptr for the default
+        Kernel *kernel = nullptr;
 
     public:
         OperatorObj(OpType opType, TensorVec inputs, TensorVec outputs);
+        virtual ~OperatorObj();
         virtual optional<vector<Shape>> inferShape(const TensorVec &inputs) = 0;
         virtual vector<DataType> inferDataType(const TensorVec &inputs) const;
         /**
@@ -31,6 +38,37 @@ namespace infini
          * function.
          */
         bool checkValid(GraphObj *graph);
+        /**
+         * @brief Describes how the op can be run on a slab of rows of its
+         * output's outermost dimension. For each input, true means the input
+         * is sliced along its outermost dimension together with the output,
+         * false means the whole input is needed by every slab.
+         *
+         * @return std::nullopt if the op can not be split this way.
+         */
+        virtual optional<vector<bool>> getTileSplit() const { return std::nullopt; }
+        /**
+         * @brief Infers output shapes whose dims are expressions of symbols.
+         * Ops that do not override it only support constant input shapes.
+         *
+         * @return std::nullopt if the shapes can not be inferred symbolically.
+         */
+        virtual optional<vector<SymShape>>
+        inferSymShape(const vector<SymShape> &inputs) const;
+        /**
+         * @brief Gets the op type followed by every attribute the outputs
+         * depend on. Two ops with equal vectors on the same inputs compute
+         * the same outputs. Ops with attributes must override it.
+         */
+        virtual vector<int> getOpAttrVector() const
+        {
+            return {type.underlying()};
+        }
+        /**
+         * @brief Whether running the op has effects besides computing its
+         * outputs, e.g. growing a state, so that it must be kept as is.
+         */
+        virtual bool hasSideEffects() const { return false; }
 
     public: // getter and setter
         const TensorVec &getInputs() const { return inputs; }
@@ -46,12 +84,23 @@ namespace infini
             IT_ASSERT(i < outputs.size(), "Index exceeded");
             return outputs.at(i);
         }
-        OpVec getPredecessors() const { return wrefs_to_refs(predecessors); }
-        OpVec getSuccessors() const { return wrefs_to_refs(successors); }
+        OpVec getPredecessors() const;
+        OpVec getSuccessors() const;
+        // Non-owning views, see TensorObj::getTargetPtrs
+        const vector<OperatorObj *> &getPredecessorPtrs() const
+        {
+            return predecessors;
+        }
+        const vector<OperatorObj *> &getSuccessorPtrs() const
+        {
+            return successors;
+        }
         OpType getOpType() const { return type; }
         // HACK: set correct data type
         DataType getDType() const { return getInputs(0)->getDType(); }
         DataType getOutDType() const { return getOutput()->getDType(); }
+        Kernel *getKernel() const { return kernel; }
+        void setKernel(Kernel *kernel) { this->kernel = kernel; }
         virtual int numInputs() const = 0;
         virtual int numOutputs() const = 0;
 
@@ -70,10 +119,12 @@ namespace infini
         vector<DataType> inferDataType() const;
 
     private:
-        void addPredecessors(const Operator &op) { predecessors.emplace_back(op); }
-        void addSuccessors(const Operator &op) { successors.emplace_back(op); }
-        void removePredecessors(const Operator &op);
-        void removeSuccessors(const Operator &op);
+        void addPredecessors(OperatorObj *op) { predecessors.emplace_back(op); }
+        void addSuccessors(OperatorObj *op) { successors.emplace_back(op); }
+        void removePredecessors(const OperatorObj *op);
+        void removeSuccessors(const OperatorObj *op);
+        // Drop the links to and from the neighbouring ops
+        void disconnect();
         void replaceInput(Tensor t1, Tensor t2);
     };
 
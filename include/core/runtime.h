@@ -10,6 +10,7 @@ namespace infini
   class GraphObj;
   class RuntimeObj;
   class BlobObj;
+  class ExecutionContextObj;
 
   using Tensor = Ref<TensorObj>;
   using Operator = Ref<OperatorObj>;
@@ -38,9 +39,13 @@ namespace infini
     virtual ~RuntimeObj() {}
 
     virtual void run(const Graph &graph) const = 0;
+    // Run the graph on the buffers of ctx; graph must be ctx's graph.
+    void run(const Graph &graph, const Ref<ExecutionContextObj> &ctx) const;
     virtual void *alloc(size_t size) = 0;
     virtual void dealloc(void *ptr) = 0;
 
+    Device getDevice() const { return device; }
+
     bool isCpu() const
     {
       return true;
@@ -61,6 +66,7 @@ namespace infini
       return instance;
     }
     void dealloc(void *ptr) override;
+    using RuntimeObj::run;
     void run(const Graph &graph) const override;
     void *alloc(size_t size) override;
     string toString() const override;
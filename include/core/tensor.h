@@ -1,8 +1,10 @@
 #pragma once
 #include "core/blob.h"
 #include "core/data_type.h"
+#include "core/dim_expr.h"
 #include "core/object.h"
 #include "core/runtime.h"
+#include "utils/small_vector.h"
 #include <cmath>
 #include <cstring>
 #include <fstream>
@@ -11,22 +13,28 @@ namespace infini
 {
     class GraphObj;
     using ShapeElem = int;
-    using Shape = vector<ShapeElem>;
+    // Up to 8 dims are stored inline, so building a Shape does not allocate
+    using Shape = SmallVector<ShapeElem, 8>;
     class TensorObj : public Object
     {
         friend class GraphObj;
+        friend class ExecutionContextObj;
+        friend class AotModuleObj;
+        friend class OperatorObj;
 
     protected:
         int dim;
 
         DataType dtype;
-        vector<WRef<OperatorObj>> targets;
-        WRef<OperatorObj> source;
+        // Non-owning, an op unlinks itself from its tensors when destroyed
+        vector<OperatorObj *> targets;
+        OperatorObj *source = nullptr;
         Blob data;
         Runtime runtime;
 
     private:
         Shape shape;
+        SymShape symShape; // Empty unless some dims are symbolic
         size_t _size; // Cache of Π(shape).
         Fuid fuid;    // Cloned tensors share the same id. Tensors constructed from
                       // scratch have a new id.
@@ -39,9 +47,16 @@ namespace infini
         size_t size() const { return _size; }
         size_t getBytes() const { return _size * dtype.getSize(); }
 
-        Shape getDims() const { return shape; }
+        const Shape &getDims() const { return shape; }
         void setShape(Shape shape_);
         size_t getRank() const { return shape.size(); }
+        /**
+         * @brief Gets the symbolic shape, which is the concrete shape unless
+         * setSymShape has been called.
+         */
+        SymShape getSymShape() const;
+        void setSymShape(SymShape shape_);
+        bool hasSymbolicDims() const { return !symShape.empty(); }
         UidBaseType getFuid() const { return fuid; }
 
         void setData(
@@ -66,16 +81,29 @@ namespace infini
             static_assert(std::is_pointer_v<T>,
                           "Raw data pointer has a type of pointer");
             IT_ASSERT(data != nullptr);
+            // Inside run(graph, ctx) the buffer belongs to the running context
+            if (void *ptr = contextDataPtr())
+                return reinterpret_cast<T>(ptr);
             return data->getPtr<T>();
         }
 
         DataType getDType() const { return dtype; }
         Runtime getRuntime() const { return runtime; }
 
-        OpVec getTargets() const { return wrefs_to_refs(targets); }
-        Operator getSource() const { return source.lock(); }
+        OpVec getTargets() const;
+        Operator getSource() const;
+        /**
+         * @brief Non-owning views of the links, for traversals that should
+         * neither allocate nor touch reference counts. They stay valid until
+         * the graph is modified.
+         */
+        const vector<OperatorObj *> &getTargetPtrs() const { return targets; }
+        OperatorObj *getSourcePtr() const { return source; }
+        size_t getNumTargets() const { return targets.size(); }
 
     private:
+        void *contextDataPtr() const;
+
         template <class T>
         string dataToString() const
         {
@@ -147,17 +175,12 @@ namespace infini
             return true;
         }
 
-        void addTarget(const Operator &op) { targets.emplace_back(op); }
-        void setSource(const Operator &op) { source = op; }
-        void removeTarget(const Operator &op)
+        void addTarget(OperatorObj *op) { targets.emplace_back(op); }
+        void setSource(OperatorObj *op) { source = op; }
+        void removeTarget(const OperatorObj *op)
         {
-            for (auto itr = targets.begin(); itr != targets.end();)
-            {
-                if (itr->lock() == op)
-                    itr = targets.erase(itr);
-                else
-                    ++itr;
-            }
+            targets.erase(std::remove(targets.begin(), targets.end(), op),
+                          targets.end());
         }
     };
 
@@ -0,0 +1,39 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini
+{
+  /**
+   * @brief Append the input to a state tensor along an axis, in place. The
+   * output is the grown state and shares its buffer, so only the appended
+   * rows are written. See GraphObj::addState.
+   *
+   */
+  class AppendObj : public OperatorObj
+  {
+  public:
+    /**
+     * @brief Construct a new AppendObj object.
+     *
+     * @param graph The graph to which this operator belongs.
+     * @param state The state tensor to grow.
+     * @param input The rows to append.
+     * @param output The state after appending.
+     * @param axis The axis to append along.
+     */
+    AppendObj(GraphObj *graph, Tensor state, Tensor input, Tensor output,
+              int axis);
+    OP_CLONE(AppendObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+    std::string toString() const override;
+    vector<int> getOpAttrVector() const override;
+    bool hasSideEffects() const override { return true; }
+    int numInputs() const override { return 2; }
+    int numOutputs() const override { return 1; }
+    int getAxis() const { return axis; }
+
+  private:
+    int axis;
+  };
+} // namespace infini
@@ -23,8 +23,12 @@ class ConcatObj : public OperatorObj {
     OP_CLONE(ConcatObj);
 
     optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    optional<vector<SymShape>>
+    inferSymShape(const vector<SymShape> &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
 
     std::string toString() const override;
+    vector<int> getOpAttrVector() const override;
     int numInputs() const override { return inputs.size(); }
     int numOutputs() const override { return 1; }
     int getDim() const { return dim; }
@@ -24,6 +24,9 @@ namespace infini
     ElementWiseObj(OpType type, GraphObj *graph, Tensor input0, Tensor input1,
                    Tensor output);
     optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    optional<vector<SymShape>>
+    inferSymShape(const vector<SymShape> &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
 
     std::string toString() const override;
     int numInputs() const override { return 2; }
@@ -43,7 +43,11 @@ namespace infini
         OP_CLONE(MatmulObj);
 
         std::string toString() const override;
+        vector<int> getOpAttrVector() const override;
         optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+        optional<vector<SymShape>>
+        inferSymShape(const vector<SymShape> &inputs) const override;
+        optional<vector<bool>> getTileSplit() const override;
 
         int numInputs() const override { return inputs.size(); }
         int numOutputs() const override { return 1; }
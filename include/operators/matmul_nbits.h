@@ -0,0 +1,74 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini
+{
+    /**
+     * @brief Weight-only quantized matrix multiplication C = A * B. A and C
+     * are Float32, B (K, N) is stored as grouped 4-bit or 8-bit integers with
+     * one Float32 scale per group, and is dequantized on the fly.
+     *
+     * Packed weight format: B is stored per output column and split into
+     * groups of `groupSize` consecutive values along K, the last group padded
+     * with zeros. The packed tensor is UInt8 of shape
+     * (N, ceil(K / groupSize), groupSize * bits / 8) and scales are Float32 of
+     * shape (N, ceil(K / groupSize)). Values are symmetric: an 8-bit value is
+     * an int8 in [-127, 127]; 4-bit values lie in [-8, 7], are stored with an
+     * offset of 8, and every 16 of them take 8 bytes where byte j holds value
+     * j in its low nibble and value j + 8 in its high nibble.
+     */
+    class MatMulNBitsObj : public OperatorObj
+    {
+    private:
+        int bits, groupSize;
+
+        // Auxiliary attributes which are not a part of operator attributes.
+        int m, n, k;
+
+    public:
+        /**
+         * @brief Construct a new MatMulNBits object.
+         *
+         * @param graph The computation graph that this operator belongs to.
+         * @param A The Float32 input tensor (..., M, K).
+         * @param B The packed weight tensor, see packWeight.
+         * @param scales The Float32 scale of every group of B.
+         * @param C The Float32 output tensor (..., M, N).
+         * @param bits 4 or 8.
+         * @param groupSize Number of values along K sharing one scale, a
+         * multiple of 16.
+         */
+        MatMulNBitsObj(GraphObj *graph, Tensor A, Tensor B, Tensor scales,
+                       Tensor C, int bits, int groupSize);
+        OP_CLONE(MatMulNBitsObj);
+
+        std::string toString() const override;
+        vector<int> getOpAttrVector() const override;
+        optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+        optional<vector<bool>> getTileSplit() const override;
+
+        int numInputs() const override { return 3; }
+        int numOutputs() const override { return 1; }
+
+        int getBits() const { return bits; }
+        int getGroupSize() const { return groupSize; }
+        int getM() const { return m; }
+        int getN() const { return n; }
+        int getK() const { return k; }
+
+        /**
+         * @brief Shapes of the packed weight and scale tensors for a (K, N)
+         * weight.
+         */
+        static Shape packedShape(int k, int n, int bits, int groupSize);
+        static Shape scalesShape(int k, int n, int groupSize);
+
+        /**
+         * @brief Quantize a row-major Float32 (K, N) weight into the packed
+         * format, with scale = max|b| / max_q per group.
+         */
+        static void packWeight(const float *b, int k, int n, int bits,
+                               int groupSize, uint8_t *packed, float *scales);
+    };
+
+} // namespace infini
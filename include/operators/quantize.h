@@ -0,0 +1,137 @@
+#pragma once
+#include "core/operator.h"
+#include <memory>
+
+namespace infini
+{
+  /**
+   * @brief Linear quantization y = saturate(round(x / scale) + zero_point),
+   * rounding half to even. Follows ONNX QuantizeLinear.
+   *
+   */
+  class QuantizeLinearObj : public OperatorObj
+  {
+  public:
+    /**
+     * @brief Construct a new QuantizeLinear object.
+     *
+     * @param graph The computation graph that this operator belongs to.
+     * @param input The Float32 input tensor.
+     * @param scale Scale, a single element for per-tensor quantization or a
+     * 1-D tensor with dims[axis] elements for per-channel quantization.
+     * @param zeroPoint Zero point with the same shape as scale. Its data type,
+     * Int8 or UInt8, is the output data type.
+     * @param output The quantized output tensor.
+     * @param axis The channel axis for per-channel quantization.
+     */
+    QuantizeLinearObj(GraphObj *graph, Tensor input, Tensor scale,
+                      Tensor zeroPoint, Tensor output, int axis = 1);
+    OP_CLONE(QuantizeLinearObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    vector<DataType> inferDataType(const TensorVec &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
+
+    std::string toString() const override;
+    vector<int> getOpAttrVector() const override;
+    int numInputs() const override { return 3; }
+    int numOutputs() const override { return 1; }
+    int getAxis() const { return axis; }
+    bool isPerTensor() const { return inputs[1]->size() == 1; }
+
+  private:
+    int axis;
+  };
+
+  /**
+   * @brief Linear dequantization y = (x - zero_point) * scale. Follows ONNX
+   * DequantizeLinear.
+   *
+   */
+  class DequantizeLinearObj : public OperatorObj
+  {
+  public:
+    /**
+     * @brief Construct a new DequantizeLinear object.
+     *
+     * @param graph The computation graph that this operator belongs to.
+     * @param input The Int8 or UInt8 input tensor.
+     * @param scale Per-tensor or per-channel scale, see QuantizeLinearObj.
+     * @param zeroPoint Zero point with the same shape and data type as input.
+     * @param output The Float32 output tensor.
+     * @param axis The channel axis for per-channel dequantization.
+     */
+    DequantizeLinearObj(GraphObj *graph, Tensor input, Tensor scale,
+                        Tensor zeroPoint, Tensor output, int axis = 1);
+    OP_CLONE(DequantizeLinearObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    vector<DataType> inferDataType(const TensorVec &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
+
+    std::string toString() const override;
+    vector<int> getOpAttrVector() const override;
+    int numInputs() const override { return 3; }
+    int numOutputs() const override { return 1; }
+    int getAxis() const { return axis; }
+    bool isPerTensor() const { return inputs[1]->size() == 1; }
+
+  private:
+    int axis;
+  };
+
+  /**
+   * @brief Quantized matrix multiplication following ONNX QLinearMatMul.
+   * A (..., M, K) and B (K, N) are Int8 or UInt8, products are accumulated in
+   * int32 and requantized with y_scale and y_zero_point. A and Y are
+   * quantized per tensor, B per tensor or per column (N elements).
+   *
+   */
+  class QLinearMatMulObj : public OperatorObj
+  {
+  public:
+    QLinearMatMulObj(GraphObj *graph, Tensor A, Tensor aScale,
+                     Tensor aZeroPoint, Tensor B, Tensor bScale,
+                     Tensor bZeroPoint, Tensor yScale, Tensor yZeroPoint,
+                     Tensor Y);
+    OP_CLONE(QLinearMatMulObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    vector<DataType> inferDataType(const TensorVec &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
+
+    std::string toString() const override;
+    int numInputs() const override { return 8; }
+    int numOutputs() const override { return 1; }
+    int getM() const { return m; }
+    int getN() const { return n; }
+    int getK() const { return k; }
+
+    /**
+     * @brief B in the layout of the CPU kernel, with what it derives from B
+     * alone. B is a weight: the kernel packs it on the first run and again
+     * only when the buffer of B or of its zero point moves, so call
+     * resetPackedWeights after overwriting them in place.
+     */
+    struct PackedWeights
+    {
+      const void *b, *bZeroPoint; // Buffers it was packed from
+      int kPad;
+      vector<int8_t> data;    // Columns of kPad s8, zero padded to 4 columns
+      vector<int32_t> colSum; // Sums of the shifted columns
+      vector<int32_t> zb;     // Shifted zero points, one per column
+    };
+    std::shared_ptr<const PackedWeights> getPackedWeights() const
+    {
+      return std::atomic_load(&packed);
+    }
+    void setPackedWeights(std::shared_ptr<const PackedWeights> weights) const
+    {
+      std::atomic_store(&packed, std::move(weights));
+    }
+    void resetPackedWeights() const { setPackedWeights(nullptr); }
+
+  private:
+    // M is the product of all leading dims of A
+    int m, n, k;
+    // Shared by concurrent runs, hence the atomic accesses
+    mutable std::shared_ptr<const PackedWeights> packed;
+  };
+} // namespace infini
@@ -22,8 +22,12 @@ namespace infini
                  vector<int> permute);
     OP_CLONE(TransposeObj);
     optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    optional<vector<SymShape>>
+    inferSymShape(const vector<SymShape> &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
 
     std::string toString() const override;
+    vector<int> getOpAttrVector() const override;
     int numInputs() const override { return 1; }
     int numOutputs() const override { return 1; }
     std::vector<int> getPermute() const { return transposePermute; }
@@ -20,6 +20,9 @@ namespace infini
      */
     UnaryObj(OpType type, GraphObj *graph, Tensor input, Tensor output);
     optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    optional<vector<SymShape>>
+    inferSymShape(const vector<SymShape> &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
 
     std::string toString() const override;
     int numInputs() const override { return 1; }
@@ -33,8 +36,12 @@ namespace infini
             std::optional<float> min, std::optional<float> max);
     OP_CLONE(ClipObj);
     optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    optional<vector<SymShape>>
+    inferSymShape(const vector<SymShape> &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
 
     std::string toString() const override;
+    vector<int> getOpAttrVector() const override;
     std::optional<float> getMin() const { return minValue; };
     std::optional<float> getMax() const { return maxValue; };
     int numInputs() const override { return 1; }
@@ -79,9 +86,13 @@ namespace infini
     CastObj(GraphObj *graph, Tensor input, Tensor output, CastType type);
     OP_CLONE(CastObj);
     optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    optional<vector<SymShape>>
+    inferSymShape(const vector<SymShape> &inputs) const override;
+    optional<vector<bool>> getTileSplit() const override;
     vector<DataType> inferDataType(const TensorVec &inputs) const override;
 
     std::string toString() const override;
+    vector<int> getOpAttrVector() const override;
     CastType getType() const { return castType; }
     DataType getOutputDataType() const;
     int numInputs() const override { return 1; }
@@ -101,4 +112,9 @@ namespace infini
   };
 
   DEFINE_UNARY_OBJ(Relu, OpType::Relu)
+  DEFINE_UNARY_OBJ(Gelu, OpType::Gelu)
+  DEFINE_UNARY_OBJ(Silu, OpType::Silu)
+  DEFINE_UNARY_OBJ(Sigmoid, OpType::Sigmoid)
+  DEFINE_UNARY_OBJ(Tanh, OpType::Tanh)
+  DEFINE_UNARY_OBJ(Exp, OpType::Exp)
 }; // namespace infini
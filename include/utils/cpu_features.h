@@ -0,0 +1,21 @@
+#pragma once
+
+namespace infini {
+
+/**
+ * @brief Instruction set extensions of the host CPU, detected once at first
+ * use. Kernels with ISA-specific paths compile them with target attributes
+ * and pick one at run time, so the library itself needs no -march flags.
+ */
+struct CpuFeatures {
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+    // 256-bit VPDPBUSD, either from AVX-VNNI or AVX512-VNNI with AVX512-VL
+    bool avxvnni = false;
+    bool avx512vnni = false;
+
+    static const CpuFeatures &get();
+};
+
+} // namespace infini
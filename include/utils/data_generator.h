@@ -1,5 +1,6 @@
 #pragma once
 #include "core/common.h"
+#include "utils/float16.h"
 #include <random>
 
 namespace infini {
@@ -16,7 +17,17 @@ public:
             fill(reinterpret_cast<uint32_t *>(data), size);
         else if (dataType == DataType::Float32)
             fill(reinterpret_cast<float *>(data), size);
-        else
+        else if (dataType == DataType::Float16 ||
+                 dataType == DataType::BFloat16) {
+            // Generate in float and round into the 16-bit storage format
+            vector<float> values(size);
+            fill(values.data(), size);
+            auto dst = reinterpret_cast<uint16_t *>(data);
+            for (size_t i = 0; i < size; i++)
+                dst[i] = dataType == DataType::Float16
+                             ? fp32_to_fp16(values[i])
+                             : fp32_to_bf16(values[i]);
+        } else
             IT_TODO_HALT();
     }
 };
@@ -0,0 +1,103 @@
+#pragma once
+#include "core/data_type.h"
+#include <cstdint>
+#include <cstring>
+
+namespace infini {
+
+// Scalar conversions between float and the 16-bit floating point storage
+// formats. DataType::Float16 and DataType::BFloat16 are both stored as
+// uint16_t bit patterns. All conversions round to nearest even and keep
+// infinities and NaNs.
+
+inline uint32_t fp32_to_bits(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+inline float fp32_from_bits(uint32_t bits) {
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// IEEE 754 binary16, including subnormals. Rounding is done by the FPU:
+// adding a power of two aligns the mantissa so that the discarded bits are
+// rounded in the current (nearest even) mode.
+inline uint16_t fp32_to_fp16(float f) {
+    const float scaleToInf = 0x1.0p+112f;
+    const float scaleToZero = 0x1.0p-110f;
+    float base = ((f < 0 ? -f : f) * scaleToInf) * scaleToZero;
+
+    const uint32_t w = fp32_to_bits(f);
+    const uint32_t shl1W = w + w;
+    const uint32_t sign = w & 0x80000000u;
+    uint32_t bias = shl1W & 0xFF000000u;
+    if (bias < 0x71000000u)
+        bias = 0x71000000u;
+
+    base = fp32_from_bits((bias >> 1) + 0x07800000u) + base;
+    const uint32_t bits = fp32_to_bits(base);
+    const uint32_t expBits = (bits >> 13) & 0x00007C00u;
+    const uint32_t mantissaBits = bits & 0x00000FFFu;
+    const uint32_t nonsign = expBits + mantissaBits;
+    // NaNs are quieted and keep the top of their payload, as F16C does
+    const uint32_t nan = 0x7E00u | ((w >> 13) & 0x03FFu);
+    return static_cast<uint16_t>((sign >> 16) |
+                                 (shl1W > 0xFF000000u ? nan : nonsign));
+}
+
+inline float fp16_to_fp32(uint16_t h) {
+    const uint32_t w = static_cast<uint32_t>(h) << 16;
+    const uint32_t sign = w & 0x80000000u;
+    const uint32_t twoW = w + w;
+
+    const uint32_t expOffset = 0xE0u << 23;
+    const float normalized =
+        fp32_from_bits((twoW >> 4) + expOffset) * 0x1.0p-112f;
+    const float denormalized =
+        fp32_from_bits((twoW >> 17) | (126u << 23)) - 0.5f;
+
+    const uint32_t denormalizedCutoff = 1u << 27;
+    return fp32_from_bits(sign | (twoW < denormalizedCutoff
+                                      ? fp32_to_bits(denormalized)
+                                      : fp32_to_bits(normalized)));
+}
+
+// bfloat16 is the upper half of a float, rounded to nearest even.
+inline uint16_t fp32_to_bf16(float f) {
+    uint32_t bits = fp32_to_bits(f);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) // quiet NaN, keep the sign
+        return static_cast<uint16_t>((bits >> 16) | 0x0040u);
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+inline float bf16_to_fp32(uint16_t b) {
+    return fp32_from_bits(static_cast<uint32_t>(b) << 16);
+}
+
+// Storage and compute types of DataType index N in CPU kernels. Float16 and
+// BFloat16 stay 16-bit in memory and are loaded into float, so arithmetic and
+// accumulation run in FP32 and are rounded once when stored.
+template <int N> struct DTCompute {
+    using storage = typename DT<N>::t;
+    using compute = storage;
+    static compute load(storage val) { return val; }
+    static storage store(compute val) { return val; }
+};
+template <> struct DTCompute<DataType::Index::Float16> {
+    using storage = uint16_t;
+    using compute = float;
+    static compute load(storage val) { return fp16_to_fp32(val); }
+    static storage store(compute val) { return fp32_to_fp16(val); }
+};
+template <> struct DTCompute<DataType::Index::BFloat16> {
+    using storage = uint16_t;
+    using compute = float;
+    static compute load(storage val) { return bf16_to_fp32(val); }
+    static storage store(compute val) { return fp32_to_bf16(val); }
+};
+
+} // namespace infini
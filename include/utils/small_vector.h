@@ -0,0 +1,241 @@
+#pragma once
+#include "core/common.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace infini {
+
+/**
+ * @brief A vector of trivially copyable elements that keeps up to N of them
+ * inline and only allocates beyond that. It offers the subset of the
+ * std::vector interface used on shapes and converts to and from std::vector
+ * implicitly.
+ */
+template <typename T, size_t N> class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "SmallVector only holds trivially copyable elements");
+
+    T *ptr;
+    size_t count;
+    size_t cap;
+    T inlineData[N];
+
+    bool isInline() const { return ptr == inlineData; }
+
+    void grow(size_t minCap) {
+        size_t newCap = std::max(minCap, cap * 2);
+        T *heap = new T[newCap];
+        std::memcpy(heap, ptr, count * sizeof(T));
+        if (!isInline())
+            delete[] ptr;
+        ptr = heap;
+        cap = newCap;
+    }
+
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SmallVector() : ptr(inlineData), count(0), cap(N) {}
+    explicit SmallVector(size_t n, const T &value = T()) : SmallVector() {
+        assign(n, value);
+    }
+    SmallVector(std::initializer_list<T> list) : SmallVector() {
+        assign(list.begin(), list.end());
+    }
+    template <typename It,
+              typename = std::enable_if_t<!std::is_integral_v<It>>>
+    SmallVector(It first, It last) : SmallVector() {
+        assign(first, last);
+    }
+    SmallVector(const std::vector<T> &v) : SmallVector() {
+        assign(v.begin(), v.end());
+    }
+    SmallVector(const SmallVector &other) : SmallVector() {
+        assign(other.begin(), other.end());
+    }
+    SmallVector(SmallVector &&other) noexcept : SmallVector() {
+        *this = std::move(other);
+    }
+    ~SmallVector() {
+        if (!isInline())
+            delete[] ptr;
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other)
+            assign(other.begin(), other.end());
+        return *this;
+    }
+    SmallVector &operator=(SmallVector &&other) noexcept {
+        if (this == &other)
+            return *this;
+        if (other.isInline()) {
+            // Inline storage can not be stolen, copy it
+            clear();
+            std::memcpy(static_cast<void *>(ptr), other.ptr,
+                        other.count * sizeof(T));
+            count = other.count;
+        } else {
+            if (!isInline())
+                delete[] ptr;
+            ptr = other.ptr;
+            cap = other.cap;
+            count = other.count;
+            other.ptr = other.inlineData;
+            other.cap = N;
+        }
+        other.count = 0;
+        return *this;
+    }
+    SmallVector &operator=(std::initializer_list<T> list) {
+        assign(list.begin(), list.end());
+        return *this;
+    }
+
+    operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+    void assign(size_t n, const T &value) {
+        clear();
+        resize(n, value);
+    }
+    template <typename It,
+              typename = std::enable_if_t<!std::is_integral_v<It>>>
+    void assign(It first, It last) {
+        clear();
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return cap; }
+    void reserve(size_t n) {
+        if (n > cap)
+            grow(n);
+    }
+    void clear() { count = 0; }
+    void resize(size_t n, const T &value = T()) {
+        reserve(n);
+        for (size_t i = count; i < n; ++i)
+            ptr[i] = value;
+        count = n;
+    }
+
+    T *data() { return ptr; }
+    const T *data() const { return ptr; }
+    T &operator[](size_t i) { return ptr[i]; }
+    const T &operator[](size_t i) const { return ptr[i]; }
+    T &at(size_t i) {
+        if (i >= count)
+            throw std::out_of_range("SmallVector::at");
+        return ptr[i];
+    }
+    const T &at(size_t i) const {
+        if (i >= count)
+            throw std::out_of_range("SmallVector::at");
+        return ptr[i];
+    }
+    T &front() { return ptr[0]; }
+    const T &front() const { return ptr[0]; }
+    T &back() { return ptr[count - 1]; }
+    const T &back() const { return ptr[count - 1]; }
+
+    iterator begin() { return ptr; }
+    iterator end() { return ptr + count; }
+    const_iterator begin() const { return ptr; }
+    const_iterator end() const { return ptr + count; }
+    const_iterator cbegin() const { return ptr; }
+    const_iterator cend() const { return ptr + count; }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    void push_back(const T &value) {
+        if (count == cap) {
+            T copy = value; // value may live in this vector
+            grow(count + 1);
+            ptr[count++] = copy;
+        } else
+            ptr[count++] = value;
+    }
+    template <typename... Args> T &emplace_back(Args &&...args) {
+        push_back(T(std::forward<Args>(args)...));
+        return back();
+    }
+    void pop_back() { --count; }
+
+    iterator insert(const_iterator pos, const T &value) {
+        return insert(pos, size_t(1), value);
+    }
+    iterator insert(const_iterator pos, size_t n, const T &value) {
+        const size_t index = pos - ptr;
+        T copy = value;
+        reserve(count + n);
+        std::memmove(ptr + index + n, ptr + index,
+                     (count - index) * sizeof(T));
+        std::fill(ptr + index, ptr + index + n, copy);
+        count += n;
+        return ptr + index;
+    }
+    template <typename It,
+              typename = std::enable_if_t<!std::is_integral_v<It>>>
+    iterator insert(const_iterator pos, It first, It last) {
+        const size_t index = pos - ptr;
+        // Copy first, the range may alias this vector
+        SmallVector values(first, last);
+        const size_t n = values.size();
+        reserve(count + n);
+        std::memmove(ptr + index + n, ptr + index,
+                     (count - index) * sizeof(T));
+        std::memcpy(ptr + index, values.data(), n * sizeof(T));
+        count += n;
+        return ptr + index;
+    }
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_t index = first - ptr, n = last - first;
+        std::memmove(ptr + index, ptr + index + n,
+                     (count - index - n) * sizeof(T));
+        count -= n;
+        return ptr + index;
+    }
+
+    friend bool operator==(const SmallVector &a, const SmallVector &b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator!=(const SmallVector &a, const SmallVector &b) {
+        return !(a == b);
+    }
+    friend bool operator<(const SmallVector &a, const SmallVector &b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                            b.end());
+    }
+};
+
+template <typename T, size_t N>
+std::string vecToString(const SmallVector<T, N> &vec) {
+    return vecToString(vec.data(), vec.size());
+}
+
+} // namespace infini
@@ -1,4 +1,5 @@
 #include "core/allocator.h"
+#include <algorithm>
 #include <utility>
 
 namespace infini
@@ -7,6 +8,7 @@ namespace infini
     {
         used = 0;
         peak = 0;
+        top = 0;
         ptr = nullptr;
 
         // 'alignment' defaults to sizeof(uint64_t), because it is the length of
@@ -50,8 +52,9 @@ namespace infini
             return addr;
         }
 
-        const size_t addr = peak;
-        peak += size;
+        const size_t addr = top;
+        top += size;
+        peak = std::max(peak, top);
         used += size;
         return addr;
     }
@@ -111,19 +114,20 @@ namespace infini
 
         freeBlocks.emplace(addr, size);
 
-        // 若空闲块位于堆顶（addr+size==peak），则可以把 peak 往回收缩。
-        // 进一步：如果收缩后的新 peak 仍然与另一个空闲块相邻，也可以继续收缩。
+        // 若空闲块位于堆顶（addr+size==top），则可以把 top 往回收缩。
+        // 进一步：如果收缩后的新 top 仍然与另一个空闲块相邻，也可以继续收缩。
+        // peak 记录历史最高水位，不随之收缩，否则已分配的偏移会越界。
         while (!freeBlocks.empty())
         {
-            auto it = freeBlocks.upper_bound(peak);
+            auto it = freeBlocks.upper_bound(top);
             if (it == freeBlocks.begin())
                 break;
             --it;
             const size_t blockAddr = it->first;
             const size_t blockSize = it->second;
-            if (blockAddr + blockSize != peak)
+            if (blockAddr + blockSize != top)
                 break;
-            peak = blockAddr;
+            top = blockAddr;
             freeBlocks.erase(it);
         }
     }
@@ -143,6 +147,27 @@ namespace infini
         return ((size - 1) / this->alignment + 1) * this->alignment;
     }
 
+    void *Allocator::detach()
+    {
+        void *memory = this->ptr;
+        this->ptr = nullptr;
+        reset();
+        return memory;
+    }
+
+    void Allocator::reset()
+    {
+        if (this->ptr != nullptr)
+        {
+            runtime->dealloc(this->ptr);
+            this->ptr = nullptr;
+        }
+        used = 0;
+        peak = 0;
+        top = 0;
+        freeBlocks.clear();
+    }
+
     void Allocator::info()
     {
         std::cout << "Used memory: " << this->used
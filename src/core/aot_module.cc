@@ -0,0 +1,427 @@
+#include "core/aot_module.h"
+#include "core/blob.h"
+#include "core/kernel.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+#include <cstdlib>
+#include <dlfcn.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace infini
+{
+    namespace
+    {
+        // C type of a dtype the generated code can compute on, or an empty
+        // string
+        string cType(DataType dtype)
+        {
+            static const std::pair<DataType, const char *> types[] = {
+                {DataType::Float32, "float"},   {DataType::Double, "double"},
+                {DataType::Int8, "int8_t"},     {DataType::UInt8, "uint8_t"},
+                {DataType::Int16, "int16_t"},   {DataType::UInt16, "uint16_t"},
+                {DataType::Int32, "int32_t"},   {DataType::UInt32, "uint32_t"},
+                {DataType::Int64, "int64_t"},   {DataType::UInt64, "uint64_t"},
+                {DataType::Bool, "bool"},
+            };
+            for (auto &[type, name] : types)
+                if (type == dtype)
+                    return name;
+            return "";
+        }
+
+        Shape contiguousStrides(const Shape &dims)
+        {
+            Shape strides(dims.size());
+            int p = 1;
+            for (size_t i = dims.size(); i > 0; --i)
+            {
+                strides[i - 1] = p;
+                p *= dims[i - 1];
+            }
+            return strides;
+        }
+
+        // Strides of `dims` indexed by the loops over the broadcast shape
+        // `outDims`: missing and size-1 dims do not move
+        Shape broadcastStrides(const Shape &dims, const Shape &outDims)
+        {
+            const size_t rank = outDims.size();
+            Shape strides(rank, 0);
+            Shape own = contiguousStrides(dims);
+            for (size_t i = 0; i < dims.size(); ++i)
+                if (dims[i] != 1)
+                    strides[rank - dims.size() + i] = own[i];
+            return strides;
+        }
+
+        // Linear index over loops `i0, i1, ...` of extents `dims`
+        string indexExpr(const Shape &dims, const Shape &strides,
+                         size_t offset = 0)
+        {
+            string expr;
+            for (size_t i = 0; i < dims.size(); ++i)
+            {
+                if (dims[i] == 1 || strides[i] == 0)
+                    continue;
+                if (!expr.empty())
+                    expr += " + ";
+                expr += "i" + std::to_string(i);
+                if (strides[i] != 1)
+                    expr += " * " + std::to_string(strides[i]);
+            }
+            if (offset || expr.empty())
+                expr += (expr.empty() ? "" : " + ") + std::to_string(offset);
+            return expr;
+        }
+
+        string literal(float value, const string &type)
+        {
+            std::ostringstream os;
+            os << "static_cast<" << type << ">(" << std::hexfloat << value << ")";
+            return os.str();
+        }
+
+        class SourceWriter
+        {
+            std::ostringstream os;
+            int depth = 1;
+
+        public:
+            void line(const string &text)
+            {
+                os << string(depth * 4, ' ') << text << '\n';
+            }
+            void open(const string &text)
+            {
+                line(text.empty() ? "{" : text + " {");
+                ++depth;
+            }
+            void close()
+            {
+                --depth;
+                line("}");
+            }
+            // Opens one loop per dim of `dims` larger than 1, returns how many
+            int openLoops(const Shape &dims)
+            {
+                int opened = 0;
+                for (size_t i = 0; i < dims.size(); ++i)
+                {
+                    if (dims[i] == 1)
+                        continue;
+                    auto var = "i" + std::to_string(i);
+                    open("for (int64_t " + var + " = 0; " + var + " < " +
+                         std::to_string(dims[i]) + "; ++" + var + ")");
+                    ++opened;
+                }
+                return opened;
+            }
+            void closeLoops(int opened)
+            {
+                while (opened--)
+                    close();
+            }
+            string str() const { return os.str(); }
+        };
+    } // namespace
+
+    AotModuleObj::AotModuleObj(const Graph &graph_)
+        : graph(graph_), arenaBase(graph_->getArenaBase()), handle(nullptr),
+          entry(nullptr) {}
+
+    AotModuleObj::~AotModuleObj()
+    {
+        if (handle)
+            dlclose(handle);
+        if (!workDir.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(workDir, ec);
+        }
+    }
+
+    string AotModuleObj::emit()
+    {
+        schedule = graph->getSchedule();
+        fallbacks.assign(schedule.size(), nullptr);
+        external.clear();
+
+        char *base = static_cast<char *>(arenaBase);
+        const size_t bytes = graph->getArenaBytes();
+        std::unordered_map<const TensorObj *, size_t> externalIndex;
+        // Pointer to the data of a tensor, typed as its dtype
+        auto pointer = [&](const Tensor &t)
+        {
+            IT_ASSERT(t->data != nullptr,
+                      "AOT compilation requires a dataMalloc'ed graph");
+            const string type = cType(t->getDType());
+            char *ptr = t->data->getPtr<char *>();
+            if (ptr >= base && ptr < base + bytes)
+                return "reinterpret_cast<" + type + " *>(arena + " +
+                       std::to_string(ptr - base) + ")";
+            auto [it, inserted] =
+                externalIndex.try_emplace(t.get(), external.size());
+            if (inserted)
+                external.emplace_back(t);
+            return "static_cast<" + type + " *>(external[" +
+                   std::to_string(it->second) + "])";
+        };
+
+        SourceWriter w;
+        for (size_t index = 0; index < schedule.size(); ++index)
+        {
+            const auto &op = schedule[index];
+            const auto type = op->getOpType();
+            bool generated = cType(op->getOutput()->getDType()) != "";
+            for (auto &t : op->getInputs())
+                generated &= cType(t->getDType()) != "";
+            if (generated)
+                switch (type.underlying())
+                {
+                case OpType::Add:
+                case OpType::Sub:
+                case OpType::Mul:
+                case OpType::Div:
+                case OpType::Relu:
+                case OpType::Clip:
+                case OpType::Transpose:
+                case OpType::Concat:
+                case OpType::MatMul:
+                    break;
+                case OpType::Cast:
+                    // Casts to integers saturate, leave them to the kernel
+                    generated = op->getOutput()->getDType() == DataType::Float32 ||
+                                op->getOutput()->getDType() == DataType::Double;
+                    break;
+                default:
+                    generated = false;
+                }
+
+            w.line("// " + std::to_string(index) + ": " + type.toString() +
+                   (generated ? "" : " (kernel)"));
+            if (!generated)
+            {
+                fallbacks[index] = op->getKernel();
+                if (!fallbacks[index])
+                    fallbacks[index] = KernelRegistry::getInstance().getKernel(
+                        getKernelAttrs(graph->getRuntime()->getDevice(), op));
+                w.line("fallback(self, " + std::to_string(index) + ");");
+                continue;
+            }
+
+            const auto &output = op->getOutput();
+            const Shape outDims = output->getDims();
+            const string t = cType(op->getInputs(0)->getDType());
+            const string n = std::to_string(output->size());
+            w.open("");
+            w.line(cType(output->getDType()) + " *__restrict y = " +
+                   pointer(output) + ";");
+            for (size_t i = 0; i < op->getInputs().size(); ++i)
+                w.line("const " + t + " *__restrict x" + std::to_string(i) +
+                       " = " + pointer(op->getInputs(i)) + ";");
+
+            switch (type.underlying())
+            {
+            case OpType::Add:
+            case OpType::Sub:
+            case OpType::Mul:
+            case OpType::Div:
+            {
+                static const std::map<OpType::underlying_t, const char *>
+                    symbols = {{OpType::Add, " + "},
+                               {OpType::Sub, " - "},
+                               {OpType::Mul, " * "},
+                               {OpType::Div, " / "}};
+                auto a = broadcastStrides(op->getInputs(0)->getDims(), outDims);
+                auto b = broadcastStrides(op->getInputs(1)->getDims(), outDims);
+                int loops = w.openLoops(outDims);
+                w.line("y[" + indexExpr(outDims, contiguousStrides(outDims)) +
+                       "] = x0[" + indexExpr(outDims, a) + "]" +
+                       symbols.at(type.underlying()) + "x1[" +
+                       indexExpr(outDims, b) + "];");
+                w.closeLoops(loops);
+                break;
+            }
+            case OpType::Relu:
+                w.open("for (int64_t i = 0; i < " + n + "; ++i)");
+                w.line("y[i] = x0[i] > " + t + "(0) ? x0[i] : " + t + "(0);");
+                w.close();
+                break;
+            case OpType::Clip:
+            {
+                auto clip = as<ClipObj>(op);
+                string value = "x0[i]";
+                if (auto min = clip->getMin())
+                    value = "std::max(" + value + ", " + literal(*min, t) + ")";
+                if (auto max = clip->getMax())
+                    value = "std::min(" + value + ", " + literal(*max, t) + ")";
+                w.open("for (int64_t i = 0; i < " + n + "; ++i)");
+                w.line("y[i] = " + value + ";");
+                w.close();
+                break;
+            }
+            case OpType::Cast:
+                w.open("for (int64_t i = 0; i < " + n + "; ++i)");
+                w.line("y[i] = static_cast<" + cType(output->getDType()) +
+                       ">(x0[i]);");
+                w.close();
+                break;
+            case OpType::Transpose:
+            {
+                auto perm = as<TransposeObj>(op)->getPermute();
+                auto inStrides = contiguousStrides(op->getInputs(0)->getDims());
+                Shape strides(perm.size());
+                for (size_t i = 0; i < perm.size(); ++i)
+                    strides[i] = inStrides[perm[i]];
+                int loops = w.openLoops(outDims);
+                w.line("y[" + indexExpr(outDims, contiguousStrides(outDims)) +
+                       "] = x0[" + indexExpr(outDims, strides) + "];");
+                w.closeLoops(loops);
+                break;
+            }
+            case OpType::Concat:
+            {
+                const int axis = as<ConcatObj>(op)->getDim();
+                const auto outStrides = contiguousStrides(outDims);
+                size_t offset = 0;
+                for (size_t i = 0; i < op->getInputs().size(); ++i)
+                {
+                    const Shape dims = op->getInputs(i)->getDims();
+                    int loops = w.openLoops(dims);
+                    w.line("y[" + indexExpr(dims, outStrides, offset) + "] = x" +
+                           std::to_string(i) + "[" +
+                           indexExpr(dims, contiguousStrides(dims)) + "];");
+                    w.closeLoops(loops);
+                    offset += static_cast<size_t>(dims[axis]) * outStrides[axis];
+                }
+                break;
+            }
+            case OpType::MatMul:
+            {
+                auto matmul = as<MatmulObj>(op);
+                const int m = matmul->getM(), nn = matmul->getN(),
+                          k = matmul->getK();
+                auto batchOf = [](const Shape &dims)
+                { return Shape(dims.begin(), dims.end() - 2); };
+                const Shape batch = batchOf(outDims);
+                auto scaled = [](Shape strides, int factor)
+                {
+                    for (auto &s : strides)
+                        s *= factor;
+                    return strides;
+                };
+                auto a = scaled(
+                    broadcastStrides(batchOf(op->getInputs(0)->getDims()), batch),
+                    m * k);
+                auto b = scaled(
+                    broadcastStrides(batchOf(op->getInputs(1)->getDims()), batch),
+                    k * nn);
+                auto c = scaled(contiguousStrides(batch), m * nn);
+                const string M = std::to_string(m), N = std::to_string(nn),
+                             K = std::to_string(k);
+                int loops = w.openLoops(batch);
+                w.line("const " + t + " *a = x0 + " + indexExpr(batch, a) + ";");
+                w.line("const " + t + " *b = x1 + " + indexExpr(batch, b) + ";");
+                w.line(t + " *c = y + " + indexExpr(batch, c) + ";");
+                w.open("for (int64_t i = 0; i < " + M + "; ++i)");
+                w.open("for (int64_t j = 0; j < " + N + "; ++j)");
+                w.line("c[i * " + N + " + j] = " + t + "(0);");
+                w.close();
+                w.open("for (int64_t p = 0; p < " + K + "; ++p)");
+                w.line("const " + t + " av = " +
+                       (matmul->getTransA() ? "a[p * " + M + " + i]"
+                                            : "a[i * " + K + " + p]") +
+                       ";");
+                w.open("for (int64_t j = 0; j < " + N + "; ++j)");
+                w.line("c[i * " + N + " + j] += av * " +
+                       (matmul->getTransB() ? "b[j * " + K + " + p]"
+                                            : "b[p * " + N + " + j]") +
+                       ";");
+                w.close();
+                w.close();
+                w.close();
+                w.closeLoops(loops);
+                break;
+            }
+            default:
+                IT_TODO_HALT();
+            }
+            w.close();
+        }
+
+        std::ostringstream os;
+        os << "// Generated by InfiniTensor for a fixed memory plan\n"
+           << "#include <algorithm>\n#include <cstdint>\n\n"
+           << "extern \"C\" void infini_aot_run(char *arena, "
+              "void *const *external,\n"
+           << "                                void (*fallback)(void *, int), "
+              "void *self) {\n"
+           << "    (void)arena; (void)external; (void)fallback; (void)self;\n"
+           << w.str() << "}\n";
+        return os.str();
+    }
+
+    string AotModuleObj::generate(const Graph &graph)
+    {
+        AotModuleObj module(graph);
+        return module.emit();
+    }
+
+    AotModule AotModuleObj::compile(const Graph &graph, const string &flags)
+    {
+        AotModule module(new AotModuleObj(graph));
+        const string source = module->emit();
+
+        auto dir = (std::filesystem::temp_directory_path() / "infini_aot_XXXXXX")
+                       .string();
+        IT_ASSERT(mkdtemp(dir.data()) != nullptr,
+                  "Cannot create a directory for AOT compilation");
+        module->workDir = dir;
+        const string src = dir + "/graph.cc", lib = dir + "/graph.so",
+                     log = dir + "/build.log";
+        std::ofstream(src) << source;
+
+        const char *cxx = std::getenv("CXX");
+        const string command = string(cxx && *cxx ? cxx : "c++") +
+                               " -std=c++17 -shared -fPIC " + flags + " -o " +
+                               lib + " " + src + " > " + log + " 2>&1";
+        IT_ASSERT(std::system(command.c_str()) == 0,
+                  "AOT compilation failed, see " + log);
+
+        module->handle = dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+        IT_ASSERT(module->handle != nullptr, string("dlopen: ") + dlerror());
+        module->entry =
+            reinterpret_cast<EntryFn>(dlsym(module->handle, "infini_aot_run"));
+        IT_ASSERT(module->entry != nullptr, string("dlsym: ") + dlerror());
+        return module;
+    }
+
+    void AotModuleObj::callFallback(void *self, int index)
+    {
+        auto *module = static_cast<AotModuleObj *>(self);
+        module->fallbacks[index]->compute(module->schedule[index],
+                                          module->graph->getRuntime().get());
+    }
+
+    void AotModuleObj::run() const
+    {
+        IT_ASSERT(graph->getArenaBase() == arenaBase,
+                  "The graph was replanned after AOT compilation");
+        vector<void *> ptrs;
+        ptrs.reserve(external.size());
+        for (auto &t : external)
+        {
+            IT_ASSERT(t->data != nullptr, "Tensor " + t->toString() +
+                                              " lost its buffer");
+            ptrs.emplace_back(t->getRawDataPtr<void *>());
+        }
+        entry(static_cast<char *>(arenaBase), ptrs.data(), callFallback,
+              const_cast<AotModuleObj *>(this));
+    }
+
+} // namespace infini
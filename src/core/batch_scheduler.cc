@@ -0,0 +1,174 @@
+#include "core/batch_scheduler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace infini
+{
+    BatchScheduler::BatchScheduler(Graph graph_, TensorVec batchedInputs_,
+                                   int maxBatch, std::chrono::microseconds maxDelay)
+        : graph(std::move(graph_)), batchedInputs(std::move(batchedInputs_)),
+          outputs(graph->getOutputs()), maxBatch(maxBatch), maxDelay(maxDelay),
+          queuedRows(0), stopping(false), numBatches(0)
+    {
+        IT_ASSERT(maxBatch > 0);
+        IT_ASSERT(!batchedInputs.empty());
+        plannedRows = batchedInputs[0]->getDims()[0];
+        for (auto &t : batchedInputs)
+        {
+            IT_ASSERT(!t->getSourcePtr(), "Batched tensors must be graph inputs");
+            IT_ASSERT(t->getRank() > 0 && t->getDims()[0] == plannedRows,
+                      "Batched inputs must share the leading dimension");
+            rowBytes.emplace_back(t->getBytes() / plannedRows);
+        }
+        // One plan per bucket: powers of two, the largest batch and the rows
+        // the graph was planned with. The other inputs, e.g. weights, are
+        // shared by the plans
+        for (int rows = 1; rows < maxBatch; rows *= 2)
+            buckets.emplace_back(rows);
+        buckets.emplace_back(maxBatch);
+        buckets.emplace_back(plannedRows);
+        std::sort(buckets.begin(), buckets.end());
+        buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+        graph->setPlanCache(buckets.size(), buckets);
+        worker = std::thread(&BatchScheduler::work, this);
+    }
+
+    BatchScheduler::~BatchScheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    std::future<vector<BatchScheduler::Buffer>>
+    BatchScheduler::submit(vector<Buffer> inputs)
+    {
+        IT_ASSERT(inputs.size() == batchedInputs.size());
+        IT_ASSERT(inputs[0].size() % rowBytes[0] == 0);
+        const int rows = static_cast<int>(inputs[0].size() / rowBytes[0]);
+        IT_ASSERT(rows > 0);
+        for (size_t i = 0; i < inputs.size(); ++i)
+            IT_ASSERT(inputs[i].size() == rows * rowBytes[i],
+                      "Inputs of a request must have the same rows");
+
+        Request request{std::move(inputs), rows,
+                        std::chrono::steady_clock::now(), {}};
+        auto future = request.result.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            IT_ASSERT(!stopping);
+            queuedRows += rows;
+            queue.emplace_back(std::move(request));
+        }
+        cv.notify_one();
+        return future;
+    }
+
+    void BatchScheduler::work()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            cv.wait(lock, [&] { return stopping || !queue.empty(); });
+            if (queue.empty())
+                break;
+            // Wait for the batch to fill up, at most until the oldest request
+            // has waited maxDelay
+            cv.wait_until(lock, queue.front().arrival + maxDelay,
+                          [&] { return stopping || queuedRows >= maxBatch; });
+
+            vector<Request> batch;
+            int rows = 0;
+            while (!queue.empty() &&
+                   (batch.empty() || rows + queue.front().rows <= maxBatch))
+            {
+                rows += queue.front().rows;
+                queuedRows -= queue.front().rows;
+                batch.emplace_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+
+            lock.unlock();
+            runBatch(batch);
+            lock.lock();
+        }
+    }
+
+    int BatchScheduler::bucket(int rows) const
+    {
+        // Batches larger than maxBatch are single requests, run unpadded
+        auto it = std::lower_bound(buckets.begin(), buckets.end(), rows);
+        return it == buckets.end() ? rows : *it;
+    }
+
+    void BatchScheduler::reshape(int rows)
+    {
+        vector<Shape> shapes;
+        for (auto &t : graph->getInputs())
+        {
+            shapes.emplace_back(t->getDims());
+            if (std::find(batchedInputs.begin(), batchedInputs.end(), t) !=
+                batchedInputs.end())
+                shapes.back()[0] = rows;
+        }
+        graph->reshape(shapes);
+        for (auto &t : outputs)
+            IT_ASSERT(t->getRank() > 0 && t->getDims()[0] == rows,
+                      "Graph outputs must keep the batch dimension");
+        plannedRows = rows;
+    }
+
+    void BatchScheduler::runBatch(vector<Request> &batch)
+    {
+        size_t done = 0;
+        try
+        {
+            int rows = 0;
+            for (auto &request : batch)
+                rows += request.rows;
+            if (bucket(rows) != plannedRows)
+                reshape(bucket(rows));
+
+            // Rows past the requests pad the batch up to its bucket
+            for (size_t i = 0; i < batchedInputs.size(); ++i)
+            {
+                auto *dst = batchedInputs[i]->getRawDataPtr<uint8_t *>();
+                for (auto &request : batch)
+                {
+                    std::memcpy(dst, request.inputs[i].data(),
+                                request.inputs[i].size());
+                    dst += request.inputs[i].size();
+                }
+                std::memset(dst, 0, (plannedRows - rows) * rowBytes[i]);
+            }
+            graph->getRuntime()->run(graph);
+            ++numBatches;
+
+            vector<uint8_t *> src;
+            for (auto &t : outputs)
+                src.emplace_back(t->getRawDataPtr<uint8_t *>());
+            for (auto &request : batch)
+            {
+                vector<Buffer> results;
+                for (size_t i = 0; i < outputs.size(); ++i)
+                {
+                    const size_t bytes =
+                        outputs[i]->getBytes() / plannedRows * request.rows;
+                    results.emplace_back(src[i], src[i] + bytes);
+                    src[i] += bytes;
+                }
+                request.result.set_value(std::move(results));
+                ++done;
+            }
+        }
+        catch (...)
+        {
+            for (size_t i = done; i < batch.size(); ++i)
+                batch[i].result.set_exception(std::current_exception());
+        }
+    }
+
+} // namespace infini
@@ -0,0 +1,105 @@
+#include "core/dim_expr.h"
+#include <algorithm>
+
+namespace infini
+{
+    DimExpr::DimExpr(int value)
+    {
+        if (value != 0)
+            terms[{}] = value;
+    }
+
+    DimExpr::DimExpr(const string &symbol) { terms[{symbol}] = 1; }
+
+    bool DimExpr::isConstant() const
+    {
+        return terms.empty() || (terms.size() == 1 && terms.begin()->first.empty());
+    }
+
+    optional<int> DimExpr::getConstant() const
+    {
+        if (!isConstant())
+            return std::nullopt;
+        return terms.empty() ? 0 : static_cast<int>(terms.begin()->second);
+    }
+
+    set<string> DimExpr::getSymbols() const
+    {
+        set<string> ret;
+        for (const auto &[monomial, coef] : terms)
+            ret.insert(monomial.begin(), monomial.end());
+        return ret;
+    }
+
+    long long DimExpr::evaluate(const map<string, int> &values) const
+    {
+        long long ret = 0;
+        for (const auto &[monomial, coef] : terms)
+        {
+            long long term = coef;
+            for (const auto &symbol : monomial)
+            {
+                auto it = values.find(symbol);
+                IT_ASSERT(it != values.end(), "Unbound symbol " + symbol);
+                term *= it->second;
+            }
+            ret += term;
+        }
+        return ret;
+    }
+
+    DimExpr DimExpr::operator+(const DimExpr &rhs) const
+    {
+        DimExpr ret = *this;
+        for (const auto &[monomial, coef] : rhs.terms)
+        {
+            auto &sum = ret.terms[monomial];
+            sum += coef;
+            if (sum == 0)
+                ret.terms.erase(monomial);
+        }
+        return ret;
+    }
+
+    DimExpr DimExpr::operator*(const DimExpr &rhs) const
+    {
+        DimExpr ret;
+        for (const auto &[lhsMonomial, lhsCoef] : terms)
+            for (const auto &[rhsMonomial, rhsCoef] : rhs.terms)
+            {
+                vector<string> monomial = lhsMonomial;
+                monomial.insert(monomial.end(), rhsMonomial.begin(),
+                                rhsMonomial.end());
+                std::sort(monomial.begin(), monomial.end());
+                auto &sum = ret.terms[monomial];
+                sum += lhsCoef * rhsCoef;
+                if (sum == 0)
+                    ret.terms.erase(monomial);
+            }
+        return ret;
+    }
+
+    string DimExpr::toString() const
+    {
+        if (terms.empty())
+            return "0";
+        std::ostringstream os;
+        bool first = true;
+        for (auto it = terms.rbegin(); it != terms.rend(); ++it)
+        {
+            const auto &[monomial, coef] = *it;
+            if (!first)
+                os << (coef < 0 ? " - " : " + ");
+            else if (coef < 0)
+                os << "-";
+            first = false;
+            const long long abs = coef < 0 ? -coef : coef;
+            if (monomial.empty() || abs != 1)
+                os << abs;
+            for (size_t i = 0; i < monomial.size(); ++i)
+                os << (i == 0 && (abs == 1) ? "" : "*") << monomial[i];
+        }
+        return os.str();
+    }
+
+} // namespace infini
@@ -0,0 +1,98 @@
+#include "core/execution_context.h"
+#include "core/blob.h"
+
+namespace infini
+{
+    static thread_local ExecutionContextObj *currentContext = nullptr;
+
+    ExecutionContextObj::ExecutionContextObj(Graph graph_)
+        : graph(std::move(graph_)), runtime(graph->getRuntime()), arena(nullptr)
+    {
+        IT_ASSERT(!graph->hasStates(),
+                  "ExecutionContext does not support graphs with states");
+        char *base = static_cast<char *>(graph->getArenaBase());
+        const size_t bytes = graph->getArenaBytes();
+        arena = runtime->alloc(bytes);
+        for (auto &t : graph->getTensors())
+        {
+            IT_ASSERT(t->data != nullptr,
+                      "ExecutionContext requires a dataMalloc'ed graph");
+            // Inputs of elided Concats resolve through their output, which
+            // may be bound
+            if (graph->getTileViewOrigin(t.get()))
+                continue;
+            char *ptr = t->data->getPtr<char *>();
+            // Graph inputs and buffers outside the arena (e.g. states) are
+            // shared unless bound; activations move to this context's arena
+            // at the same offset
+            const bool activation =
+                t->getSourcePtr() && ptr >= base && ptr < base + bytes;
+            ptrs[t.get()] = activation
+                                ? static_cast<char *>(arena) + (ptr - base)
+                                : ptr;
+        }
+        for (auto &op : graph->getSchedule())
+        {
+            for (auto &t : op->getInputs())
+                if (auto origin = graph->getTileViewOrigin(t.get()))
+                    views[t.get()] = *origin;
+            for (auto &t : op->getOutputs())
+                if (auto origin = graph->getTileViewOrigin(t.get()))
+                    views[t.get()] = *origin;
+        }
+    }
+
+    ExecutionContextObj::~ExecutionContextObj()
+    {
+        for (void *ptr : owned)
+            runtime->dealloc(ptr);
+        runtime->dealloc(arena);
+    }
+
+    void ExecutionContextObj::bind(const Tensor &tensor, void *ptr)
+    {
+        IT_ASSERT(ptr != nullptr);
+        auto it = ptrs.find(tensor.get());
+        IT_ASSERT(it != ptrs.end(), "Tensor is not part of the context's graph");
+        IT_ASSERT(!tensor->getSourcePtr() || tensor->getNumTargets() == 0,
+                  "Only graph inputs and outputs can be bound");
+        it->second = static_cast<char *>(ptr);
+    }
+
+    void ExecutionContextObj::setData(
+        const Tensor &tensor,
+        std::function<void(void *, size_t, DataType)> const &generator)
+    {
+        auto it = ptrs.find(tensor.get());
+        IT_ASSERT(it != ptrs.end(), "Tensor is not part of the context's graph");
+        if (!tensor->getSourcePtr() &&
+            it->second == tensor->data->getPtr<char *>())
+        {
+            owned.emplace_back(runtime->alloc(tensor->getBytes()));
+            it->second = static_cast<char *>(owned.back());
+        }
+        generator(it->second, tensor->size(), tensor->getDType());
+    }
+
+    void *ExecutionContextObj::resolve(const TensorObj *tensor) const
+    {
+        auto it = ptrs.find(tensor);
+        if (it != ptrs.end())
+            return it->second;
+        auto viewIt = views.find(tensor);
+        IT_ASSERT(viewIt != views.end(),
+                  "Tensor is not part of the context's graph");
+        return ptrs.at(viewIt->second.first) + viewIt->second.second;
+    }
+
+    ExecutionContextObj *ExecutionContextObj::current() { return currentContext; }
+
+    ExecutionContextObj::Scope::Scope(ExecutionContextObj *ctx)
+        : previous(currentContext)
+    {
+        currentContext = ctx;
+    }
+
+    ExecutionContextObj::Scope::~Scope() { currentContext = previous; }
+
+} // namespace infini
@@ -1,7 +1,12 @@
 #include "core/graph.h"
 #include "core/blob.h"
+#include "core/kernel.h"
+#include "operators/append.h"
+#include "operators/concat.h"
 #include "operators/matmul.h"
+#include "operators/quantize.h"
 #include "operators/transpose.h"
+#include "operators/unary.h"
 #include <algorithm>
 #include <numeric>
 #include <queue>
@@ -13,14 +18,16 @@ namespace infini
     {
         sorted = false;
         ops.push_back(op);
+        if (bulkBuilding)
+            return;
         for (auto &input : op->getInputs())
         {
             if (input)
             {
-                input->addTarget(op);
-                if (auto pred = input->getSource())
+                input->addTarget(op.get());
+                if (auto *pred = input->getSourcePtr())
                 {
-                    pred->addSuccessors(op);
+                    pred->addSuccessors(op.get());
                     op->addPredecessors(pred);
                 }
             }
@@ -29,10 +36,10 @@ namespace infini
         {
             if (output)
             {
-                output->setSource(op);
-                for (auto &succ : output->getTargets())
+                output->setSource(op.get());
+                for (auto *succ : output->getTargetPtrs())
                 {
-                    succ->addPredecessors(op);
+                    succ->addPredecessors(op.get());
                     op->addSuccessors(succ);
                 }
             }
@@ -50,9 +57,9 @@ namespace infini
         for (const auto &op : ops)
         {
             vector<UidBaseType> preds, succs;
-            for (auto &o : op->getPredecessors())
+            for (auto *o : op->getPredecessorPtrs())
                 preds.emplace_back(o->getGuid());
-            for (auto &o : op->getSuccessors())
+            for (auto *o : op->getSuccessorPtrs())
                 succs.emplace_back(o->getGuid());
             oss << "OP " << op->getGuid();
             oss << ", pred " << vecToString(preds);
@@ -83,7 +90,7 @@ namespace infini
                     std::all_of(inputs.begin(), inputs.end(),
                                 [&flags](auto const &input)
                                 {
-                                    auto ptr = input->getSource().get();
+                                    auto ptr = input->getSourcePtr();
                                     return !ptr || flags.find(ptr) != flags.end();
                                 }))
                 {
@@ -140,6 +147,10 @@ namespace infini
             return inv == p2;
         };
 
+        eliminateDeadCode();
+        eliminateCommonSubexpressions();
+        simplifyAlgebra();
+
         bool changed = true;
         while (changed)
         {
@@ -153,12 +164,11 @@ namespace infini
                     continue;
                 auto t1 = as<TransposeObj>(op1);
                 auto out1 = t1->getOutput();
-                auto targets = out1->getTargets();
-                if (targets.size() != 1)
-                    continue;
-                auto op2 = targets[0];
-                if (!op2 || op2->getOpType() != OpType::Transpose)
+                const auto &targets = out1->getTargetPtrs();
+                if (targets.size() != 1 ||
+                    targets[0]->getOpType() != OpType::Transpose)
                     continue;
+                auto op2 = targets[0]->shared_from_this();
                 auto t2 = as<TransposeObj>(op2);
                 if (t2->getInputs(0) != out1)
                     continue;
@@ -167,6 +177,8 @@ namespace infini
 
                 auto in = t1->getInputs(0);
                 auto out2 = t2->getOutput();
+                if (isOutput(out1.get()) || isOutput(out2.get()))
+                    continue;
                 for (auto &consumer : out2->getTargets())
                     consumer->replaceInput(out2, in);
 
@@ -188,11 +200,11 @@ namespace infini
                 for (int inputIdx = 0; inputIdx < 2; ++inputIdx)
                 {
                     auto in = mm->getInputs(inputIdx);
-                    auto src = in->getSource();
+                    auto *src = in->getSourcePtr();
                     if (!src || src->getOpType() != OpType::Transpose)
                         continue;
-                    auto tr = as<TransposeObj>(src);
-                    if (tr->getOutput() != in)
+                    auto tr = as<TransposeObj>(src->shared_from_this());
+                    if (tr->getOutput() != in || isOutput(in.get()))
                         continue;
                     if (!isSwapLast2Permute(tr->getPermute()))
                         continue;
@@ -203,10 +215,18 @@ namespace infini
                         mm->setTransA(!mm->getTransA());
                     else
                         mm->setTransB(!mm->getTransB());
-                    toRemove.insert(src.get());
+                    toRemove.insert(src);
                     changed = true;
                 }
             }
+            // transpose 的输出仍有其它消费者时保留
+            for (auto it = toRemove.begin(); it != toRemove.end();)
+            {
+                if ((*it)->getOutput()->getNumTargets() != 0)
+                    it = toRemove.erase(it);
+                else
+                    ++it;
+            }
             if (!toRemove.empty())
             {
                 ops.erase(std::remove_if(ops.begin(), ops.end(),
@@ -216,7 +236,309 @@ namespace infini
             }
         }
 
+        rebuildConnections();
+        fuseQuantizedMatmul();
+
+        sorted = false;
+        IT_ASSERT(topo_sort() == true);
+    }
+
+    void GraphObj::setOutputs(const TensorVec &outputs)
+    {
+        for (auto &t : outputs)
+            IT_ASSERT(std::find(tensors.begin(), tensors.end(), t) !=
+                          tensors.end(),
+                      "Tensor is not in the graph");
+        markedOutputs = outputs;
+    }
+
+    bool GraphObj::isOutput(const TensorObj *tensor) const
+    {
+        if (markedOutputs.empty())
+            return tensor->getNumTargets() == 0;
+        for (auto &t : markedOutputs)
+            if (t.get() == tensor)
+                return true;
+        return false;
+    }
+
+    void GraphObj::eliminateDeadCode()
+    {
+        if (markedOutputs.empty())
+            return;
+        // 逆拓扑序传播活跃性：输出被需要或有副作用的算子保留
+        IT_ASSERT(topo_sort() == true);
+        std::unordered_set<const TensorObj *> live;
+        for (auto &t : markedOutputs)
+            live.insert(t.get());
+        std::unordered_set<OperatorObj *> dead;
+        for (auto it = ops.rbegin(); it != ops.rend(); ++it)
+        {
+            auto &op = *it;
+            bool needed = op->hasSideEffects();
+            for (auto &output : op->getOutputs())
+                needed = needed || live.count(output.get()) != 0;
+            if (!needed)
+            {
+                dead.insert(op.get());
+                continue;
+            }
+            for (auto &input : op->getInputs())
+                live.insert(input.get());
+        }
+        if (dead.empty())
+            return;
+
+        ops.erase(std::remove_if(ops.begin(), ops.end(),
+                                 [&](const Operator &op)
+                                 { return dead.count(op.get()) != 0; }),
+                  ops.end());
+        rebuildConnections();
+    }
+
+    void GraphObj::eliminateCommonSubexpressions()
+    {
+        // 按拓扑序处理，合并后下游算子的输入随之相同，可继续合并
+        IT_ASSERT(topo_sort() == true);
+        std::map<std::pair<vector<int>, vector<TensorObj *>>, OperatorObj *>
+            seen;
+        std::unordered_set<OperatorObj *> removed;
+        for (auto &op : ops)
+        {
+            if (op->hasSideEffects())
+                continue;
+            vector<TensorObj *> inputs;
+            inputs.reserve(op->getInputs().size());
+            for (auto &input : op->getInputs())
+                inputs.emplace_back(input.get());
+            auto [it, inserted] = seen.try_emplace(
+                {op->getOpAttrVector(), std::move(inputs)}, op.get());
+            if (inserted)
+                continue;
+            // 图输出、外部绑定与状态张量保留其生产者
+            auto *kept = it->second;
+            bool mergeable = kept->getOutputs().size() == op->getOutputs().size();
+            for (auto &output : op->getOutputs())
+            {
+                mergeable = mergeable && !isOutput(output.get()) &&
+                            boundData.count(output.get()) == 0;
+                for (auto &state : states)
+                    mergeable = mergeable && state.tensor != output;
+            }
+            if (!mergeable)
+                continue;
+            for (size_t i = 0; i < op->getOutputs().size(); ++i)
+            {
+                auto output = op->getOutput(i);
+                for (auto &consumer : output->getTargets())
+                    consumer->replaceInput(output, kept->getOutput(i));
+            }
+            removed.insert(op.get());
+        }
+        if (removed.empty())
+            return;
+
+        ops.erase(std::remove_if(ops.begin(), ops.end(),
+                                 [&](const Operator &op)
+                                 { return removed.count(op.get()) != 0; }),
+                  ops.end());
+        rebuildConnections();
+    }
+
+    // Cast 对 (to, back)：先 to 再 back 能精确还原输入
+    static bool isLosslessRoundTrip(CastType to, CastType back)
+    {
+        static const std::pair<CastType, CastType> roundTrips[] = {
+            {CastType::Float162Float, CastType::Float2Float16},
+            {CastType::BFloat162Float, CastType::Float2BFloat16},
+            {CastType::Int82Int32, CastType::Int322Int8},
+            {CastType::Int82Float, CastType::Float2Int8},
+            {CastType::Int162Int32, CastType::Int322Int16},
+            {CastType::Int162Float, CastType::Float2Int16},
+            {CastType::Int322Int64, CastType::Int642Int32},
+            {CastType::Uint322Int64, CastType::Int642Uint32},
+        };
+        for (auto &[a, b] : roundTrips)
+            if (a == to && b == back)
+                return true;
+        return false;
+    }
+
+    void GraphObj::simplifyAlgebra()
+    {
+        auto isIdentity = [](const Operator &op) -> bool
+        {
+            switch (op->getOpType().underlying())
+            {
+            case OpType::Clip:
+            {
+                auto clip = as<ClipObj>(op);
+                return !clip->getMin() && !clip->getMax();
+            }
+            case OpType::Cast:
+                return op->getInputs(0)->getDType() == op->getOutDType();
+            case OpType::Transpose:
+            {
+                auto perm = as<TransposeObj>(op)->getPermute();
+                for (size_t i = 0; i < perm.size(); ++i)
+                    if (perm[i] != static_cast<int>(i))
+                        return false;
+                return true;
+            }
+            default:
+                return false;
+            }
+        };
+        // 本轮被改写为无人消费的张量，其生产者随后被清理
+        std::unordered_set<const TensorObj *> emptied;
+        // from 的消费者改读 to；from 为图输出时不能省去
+        auto bypass = [&](const Tensor &from, const Tensor &to) -> bool
+        {
+            if (isOutput(from.get()))
+                return false;
+            for (auto &consumer : from->getTargets())
+                consumer->replaceInput(from, to);
+            emptied.insert(from.get());
+            return true;
+        };
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (size_t i = 0; i < ops.size(); ++i)
+            {
+                auto op = ops[i];
+                if (op->getOutputs().size() != 1 ||
+                    op->getOutput()->getNumTargets() == 0)
+                    continue;
+                auto in = op->getInputs(0), out = op->getOutput();
+                if (isIdentity(op))
+                {
+                    changed = bypass(out, in) || changed;
+                    continue;
+                }
+                // 连续 transpose 合成一个；第一个若无其它消费者随后被清理
+                const auto &targets = out->getTargetPtrs();
+                if (targets.size() != 1 || isOutput(out.get()) ||
+                    targets[0]->getOpType() != op->getOpType())
+                    continue;
+                auto next = targets[0]->shared_from_this();
+                if (op->getOpType() == OpType::Transpose)
+                {
+                    auto p1 = as<TransposeObj>(op)->getPermute();
+                    auto p2 = as<TransposeObj>(next)->getPermute();
+                    vector<int> perm(p2.size());
+                    for (size_t j = 0; j < p2.size(); ++j)
+                        perm[j] = p1[p2[j]];
+                    auto fused = make_arena_ref<TransposeObj>(
+                        arena, nullptr, in, next->getOutput(), perm);
+                    std::replace(ops.begin(), ops.end(), next, Operator(fused));
+                    // next 可能仍被外部持有，不能等析构时才解除对 out 的引用
+                    out->removeTarget(next.get());
+                    emptied.insert(out.get());
+                    changed = true;
+                }
+                else if (op->getOpType() == OpType::Cast &&
+                         isLosslessRoundTrip(as<CastObj>(op)->getType(),
+                                             as<CastObj>(next)->getType()))
+                {
+                    changed = bypass(next->getOutput(), in) || changed;
+                }
+            }
+            if (!changed)
+                break;
+            // 逆序清理，被删算子的输入若因此无人消费也一并清理
+            std::unordered_set<OperatorObj *> dead;
+            for (auto it = ops.rbegin(); it != ops.rend(); ++it)
+            {
+                auto &op = *it;
+                bool unused = !op->hasSideEffects();
+                for (auto &output : op->getOutputs())
+                    unused = unused && emptied.count(output.get()) != 0 &&
+                             output->getNumTargets() == 0;
+                if (!unused)
+                    continue;
+                dead.insert(op.get());
+                for (auto &input : op->getInputs())
+                {
+                    input->removeTarget(op.get());
+                    if (input->getNumTargets() == 0 &&
+                        (markedOutputs.empty() || !isOutput(input.get())))
+                        emptied.insert(input.get());
+                }
+            }
+            emptied.clear();
+            ops.erase(std::remove_if(ops.begin(), ops.end(),
+                                     [&](const Operator &op)
+                                     { return dead.count(op.get()) != 0; }),
+                      ops.end());
+            rebuildConnections();
+        }
+    }
+
+    void GraphObj::fuseQuantizedMatmul()
+    {
+        // DequantizeLinear(A), DequantizeLinear(B) -> MatMul -> QuantizeLinear
+        // 折叠为 QLinearMatMul
+        std::unordered_map<OperatorObj *, Operator> replaced;
+        std::unordered_set<OperatorObj *> removed;
+        for (auto &op : ops)
+        {
+            if (op->getOpType() != OpType::MatMul)
+                continue;
+            auto mm = as<MatmulObj>(op);
+            if (mm->getTransA() || mm->getTransB())
+                continue;
+            auto *srcA = mm->getInputs(0)->getSourcePtr();
+            auto *srcB = mm->getInputs(1)->getSourcePtr();
+            const auto &targets = mm->getOutput()->getTargetPtrs();
+            if (!srcA || srcA->getOpType() != OpType::DequantizeLinear ||
+                !srcB || srcB->getOpType() != OpType::DequantizeLinear ||
+                targets.size() != 1 ||
+                targets[0]->getOpType() != OpType::QuantizeLinear ||
+                isOutput(mm->getOutput().get()))
+                continue;
+            auto dqA = as<DequantizeLinearObj>(srcA->shared_from_this());
+            auto dqB = as<DequantizeLinearObj>(srcB->shared_from_this());
+            auto q = as<QuantizeLinearObj>(targets[0]->shared_from_this());
+            // A 与输出按张量量化；B 为二维权重，按张量或按列（axis=1）量化
+            if (!dqA->isPerTensor() || !q->isPerTensor() ||
+                dqB->getInputs(0)->getRank() != 2 ||
+                (!dqB->isPerTensor() && dqB->getAxis() != 1))
+                continue;
+
+            replaced[op.get()] = make_arena_ref<QLinearMatMulObj>(
+                arena, nullptr, dqA->getInputs(0), dqA->getInputs(1),
+                dqA->getInputs(2), dqB->getInputs(0), dqB->getInputs(1),
+                dqB->getInputs(2), q->getInputs(1), q->getInputs(2),
+                q->getOutput());
+            removed.insert(q.get());
+            for (auto *dq : {srcA, srcB})
+                if (dq->getOutput()->getNumTargets() == 1 &&
+                    !isOutput(dq->getOutput().get()))
+                    removed.insert(dq);
+        }
+        if (replaced.empty())
+            return;
+
+        OpVec kept;
+        kept.reserve(ops.size());
+        for (auto &op : ops)
+        {
+            if (auto it = replaced.find(op.get()); it != replaced.end())
+                kept.emplace_back(it->second);
+            else if (removed.count(op.get()) == 0)
+                kept.emplace_back(op);
+        }
+        ops = std::move(kept);
+        rebuildConnections();
+    }
+
+    void GraphObj::rebuildConnections()
+    {
         // 清理不再被任何算子引用的张量
+        TensorVec dropped;
         {
             std::unordered_set<TensorObj *> referenced;
             referenced.reserve(tensors.size());
@@ -232,19 +554,39 @@ namespace infini
             for (auto &t : tensors)
                 if (referenced.count(t.get()) != 0)
                     kept.emplace_back(t);
+                else
+                    dropped.emplace_back(t);
             tensors = std::move(kept);
         }
 
         // 重新构建 pred/succ 与 tensor source/target
+        for (auto &t : dropped)
+        {
+            t->targets.clear();
+            t->source = nullptr;
+        }
         for (auto &t : tensors)
         {
             t->targets.clear();
-            t->source.reset();
+            t->source = nullptr;
         }
         for (auto &op : ops)
         {
-            op->predecessors.clear();
-            op->successors.clear();
+            // 从邻居处一并解除，已移出图的算子不会留下悬空指针
+            op->disconnect();
+        }
+        connectAll();
+    }
+
+    void GraphObj::connectAll()
+    {
+        for (auto &op : ops)
+        {
+            for (auto &output : op->getOutputs())
+            {
+                if (output)
+                    output->setSource(op.get());
+            }
         }
         for (auto &op : ops)
         {
@@ -252,23 +594,16 @@ namespace infini
             {
                 if (input)
                 {
-                    input->addTarget(op);
-                    if (auto pred = input->getSource())
+                    input->addTarget(op.get());
+                    if (auto *pred = input->getSourcePtr())
                     {
-                        pred->addSuccessors(op);
+                        pred->addSuccessors(op.get());
                         op->addPredecessors(pred);
                     }
                 }
             }
-            for (auto &output : op->getOutputs())
-            {
-                if (output)
-                    output->setSource(op);
-            }
         }
-
         sorted = false;
-        IT_ASSERT(topo_sort() == true);
     }
 
     Tensor GraphObj::getTensor(int fuid) const
@@ -294,22 +629,48 @@ namespace infini
             // replace the old outputshape and size with new one
             for (int i = 0; i < (int)ans.value().size(); ++i)
             {
-                auto newShape = ans.value()[i];
-                auto oldShape = oldOutputs[i]->getDims();
-                auto fuid = oldOutputs[i]->getFuid();
-                if (newShape != oldShape)
-                {
-                    auto tensor = this->getTensor(fuid);
-                    tensor->setShape(newShape);
-                }
+                auto &newShape = ans.value()[i];
+                if (newShape != oldOutputs[i]->getDims())
+                    oldOutputs[i]->setShape(newShape);
             }
         }
     }
 
     void GraphObj::dataMalloc()
     {
+        IT_ASSERT(!bulkBuilding, "finalize() the graph before dataMalloc");
         // topological sorting first
         IT_ASSERT(topo_sort() == true);
+        // 重新规划：旧的 blob 全部失效，之后会被重新设置
+        allocator.reset();
+        activePlan = nullptr;
+        symArena.reset();
+        symArenaBytes = 0;
+
+        // 外部绑定的张量、状态张量及其 Append 输出使用各自的 buffer，
+        // 不参与规划；其余张量按状态写满时的形状规划，之后状态增长无需重新规划
+        std::unordered_map<TensorObj *, void *> external;
+        for (auto &[t, ptr] : boundData)
+            external[const_cast<TensorObj *>(t)] = ptr;
+        vector<Shape> stateDims;
+        for (auto &state : states)
+        {
+            external[state.tensor.get()] = state.buffer.get();
+            for (auto *op : state.tensor->getTargetPtrs())
+                if (op->getOpType() == OpType::Append &&
+                    op->getInputs(0) == state.tensor)
+                    external[op->getOutput().get()] = state.buffer.get();
+            stateDims.emplace_back(state.tensor->getDims());
+            auto full = stateDims.back();
+            full[state.axis] = state.capacity - appendedRows(state);
+            state.tensor->setShape(full);
+        }
+        for (auto &[t, input] : planInputs)
+            if (t->getDims() == input.dims)
+                external.emplace(const_cast<TensorObj *>(t), input.buffer.get());
+        if (!states.empty())
+            shape_infer();
+        findTileStreams();
 
         std::unordered_map<TensorObj *, int> remainingUses;
         std::unordered_map<TensorObj *, size_t> bytes;
@@ -323,31 +684,106 @@ namespace infini
         for (auto &t : tensors)
         {
             bytes[t.get()] = t->getBytes();
-            remainingUses[t.get()] = static_cast<int>(t->getTargets().size());
-            if (t->getTargets().empty())
+            remainingUses[t.get()] = static_cast<int>(t->getNumTargets());
+            if (isOutput(t.get()))
                 keepAlive.insert(t.get());
         }
 
-        auto ensureAlloc = [&](const Tensor &t)
+        // 流式执行链：链头 -> 链；中间张量只分配一个 tile 大小的 scratch
+        std::unordered_map<OperatorObj *, const TileStream *> streamHeads;
+        std::unordered_set<OperatorObj *> streamed;
+        std::unordered_map<TensorObj *, size_t> scratchBytes;
+        for (auto &stream : tileStreams)
         {
-            auto *p = t.get();
-            if (offsets.find(p) == offsets.end())
-                offsets[p] = allocator.alloc(bytes[p]);
-        };
+            streamHeads[stream.ops[0].get()] = &stream;
+            for (auto &op : stream.ops)
+                streamed.insert(op.get());
+            for (size_t i = 0; i + 1 < stream.ops.size(); ++i)
+            {
+                auto t = stream.ops[i]->getOutput();
+                scratchBytes[t.get()] =
+                    bytes[t.get()] / t->getDims()[0] * stream.rows;
+            }
+        }
 
-        // 输入张量：dataMalloc 后会 setData
-        for (auto &t : getInputs())
-            ensureAlloc(t);
+        // 形状随状态长度变化的张量：此处按写满的状态规划，运行时更小
+        std::unordered_set<const TensorObj *> stateDependent;
+        for (auto &state : states)
+            stateDependent.insert(state.tensor.get());
+        if (!stateDependent.empty())
+            for (auto &op : ops)
+                for (auto &in : op->getInputs())
+                    if (stateDependent.count(in.get()) != 0)
+                    {
+                        for (auto &out : op->getOutputs())
+                            stateDependent.insert(out.get());
+                        break;
+                    }
 
-        // 遍历 op：分配输出、回收“已完成最后一次使用”的输入
+        // Concat 消除：各输入在输出中是连续切片（拼接维之前的维度都为 1），
+        // 且只为该 concat 而生产时，生产者直接写入输出的切片，concat 不再执行。
+        // 输入形状随状态变化时切片偏移不固定，不消除
+        elidedOps.clear();
+        std::unordered_map<TensorObj *, std::pair<Tensor, size_t>> sliceOf;
         for (auto &op : ops)
         {
-            for (auto &out : op->getOutputs())
-                ensureAlloc(out);
+            if (op->getOpType() != OpType::Concat || streamed.count(op.get()) ||
+                external.count(op->getOutput().get()))
+                continue;
+            auto out = op->getOutput();
+            const auto &dims = out->getDims();
+            const int axis = as<ConcatObj>(op)->getDim();
+            if (std::any_of(dims.begin(), dims.begin() + axis,
+                            [](int d) { return d != 1; }))
+                continue;
+            bool aliasable = true;
+            std::unordered_set<TensorObj *> seen;
+            for (auto &in : op->getInputs())
+            {
+                auto *p = in.get();
+                auto *src = in->getSourcePtr();
+                aliasable = aliasable && src && elidedOps.count(src) == 0 &&
+                            in->getNumTargets() == 1 && !isOutput(p) &&
+                            external.count(p) == 0 &&
+                            scratchBytes.count(p) == 0 &&
+                            stateDependent.count(p) == 0 &&
+                            seen.insert(p).second;
+            }
+            if (!aliasable)
+                continue;
+            size_t offset = 0;
+            for (auto &in : op->getInputs())
+            {
+                sliceOf[in.get()] = {out, offset};
+                offset += bytes[in.get()];
+            }
+            elidedOps.insert(op.get());
+        }
 
+        std::function<void(const Tensor &)> ensureAlloc = [&](const Tensor &t)
+        {
+            auto *p = t.get();
+            if (external.count(p) != 0 || offsets.find(p) != offsets.end())
+                return;
+            auto sliceIt = sliceOf.find(p);
+            if (sliceIt == sliceOf.end())
+            {
+                offsets[p] = allocator.alloc(bytes[p]);
+                return;
+            }
+            // 切片随第一个生产者一起分配整个 concat 输出
+            auto &[out, offset] = sliceIt->second;
+            ensureAlloc(out);
+            offsets[p] = offsets[out.get()] + offset;
+        };
+
+        auto releaseInputs = [&](const Operator &op)
+        {
             for (auto &in : op->getInputs())
             {
                 auto *p = in.get();
+                if (scratchBytes.count(p) != 0 || sliceOf.count(p) != 0)
+                    continue;
                 auto it = remainingUses.find(p);
                 if (it == remainingUses.end())
                     continue;
@@ -360,23 +796,724 @@ namespace infini
                         allocator.free(offIt->second, bytes[p]);
                 }
             }
+        };
+
+        // 没有消费者、也不是图输出的张量在写入后即可回收
+        auto releaseDeadOutput = [&](const Tensor &t)
+        {
+            auto *p = t.get();
+            if (t->getNumTargets() != 0 || keepAlive.count(p) != 0)
+                return;
+            auto offIt = offsets.find(p);
+            if (offIt != offsets.end())
+                allocator.free(offIt->second, bytes[p]);
+        };
+
+        // 输入张量：dataMalloc 后会 setData
+        for (auto &t : getInputs())
+            ensureAlloc(t);
+
+        // 遍历 op：分配输出、回收“已完成最后一次使用”的输入
+        for (auto &op : ops)
+        {
+            if (streamed.count(op.get()) == 0)
+            {
+                for (auto &out : op->getOutputs())
+                    ensureAlloc(out);
+                releaseInputs(op);
+                for (auto &out : op->getOutputs())
+                    releaseDeadOutput(out);
+                continue;
+            }
+
+            // 整条链在链头处一次性规划，链中其余 op 跳过
+            auto headIt = streamHeads.find(op.get());
+            if (headIt == streamHeads.end())
+                continue;
+            const auto &chain = headIt->second->ops;
+            for (size_t i = 0; i + 1 < chain.size(); ++i)
+            {
+                auto *p = chain[i]->getOutput().get();
+                offsets[p] = allocator.alloc(scratchBytes[p]);
+            }
+            ensureAlloc(chain.back()->getOutput());
+            for (auto &chainOp : chain)
+                releaseInputs(chainOp);
+            releaseDeadOutput(chain.back()->getOutput());
+            for (size_t i = 0; i + 1 < chain.size(); ++i)
+            {
+                auto *p = chain[i]->getOutput().get();
+                allocator.free(offsets[p], scratchBytes[p]);
+            }
         }
 
         void *base = allocator.getPtr();
         for (auto &t : tensors)
         {
+            auto extIt = external.find(t.get());
+            if (extIt != external.end())
+            {
+                t->setDataBlob(make_ref<BlobObj>(runtime, extIt->second));
+                continue;
+            }
             auto it = offsets.find(t.get());
             IT_ASSERT(it != offsets.end(), "Tensor not allocated in dataMalloc");
             void *ptr = static_cast<void *>(static_cast<char *>(base) + it->second);
             t->setDataBlob(make_ref<BlobObj>(runtime, ptr));
         }
+        buildSchedule();
+        // 被消除 concat 的输入是其输出的切片，输出被绑定时随之重新指向
+        for (auto &[p, slice] : sliceOf)
+            tileViewOrigins[p] = {slice.first.get(), slice.second};
+
+        if (!states.empty())
+        {
+            for (size_t i = 0; i < states.size(); ++i)
+                states[i].tensor->setShape(stateDims[i]);
+            shape_infer();
+        }
+
+        selectKernels(true);
 
         allocator.info();
     }
 
+    void GraphObj::findTileStreams()
+    {
+        tileStreams.clear();
+        schedule.clear();
+        // 状态增长会改变形状，而 tile 视图的形状是固定的
+        if (tileBytes == 0 || !states.empty())
+            return;
+
+        auto outerRows = [](const Tensor &t)
+        { return t->getRank() == 0 ? 0 : t->getDims()[0]; };
+
+        for (size_t i = 0; i < ops.size();)
+        {
+            size_t j = i + 1;
+            const auto &head = ops[i];
+            if (head->getTileSplit() && head->getOutputs().size() == 1 &&
+                outerRows(head->getOutput()) >= 2)
+            {
+                const int rows = outerRows(head->getOutput());
+                // 后继必须紧随其后，且是前一个输出的唯一消费者并按行切分读取它
+                for (; j < ops.size(); ++j)
+                {
+                    auto out = ops[j - 1]->getOutput();
+                    auto next = ops[j];
+                    const auto &targets = out->getTargetPtrs();
+                    if (targets.size() != 1 || targets[0] != next.get() ||
+                        isOutput(out.get()))
+                        break;
+                    auto split = next->getTileSplit();
+                    if (!split || next->getOutputs().size() != 1 ||
+                        outerRows(next->getOutput()) != rows)
+                        break;
+                    int uses = 0;
+                    bool sliced = true;
+                    for (size_t k = 0; k < next->getInputs().size(); ++k)
+                    {
+                        if (next->getInputs(k) == out)
+                        {
+                            ++uses;
+                            sliced = sliced && (*split)[k];
+                        }
+                    }
+                    if (uses != 1 || !sliced)
+                        break;
+                }
+            }
+            if (j - i >= 2)
+            {
+                OpVec chain(ops.begin() + i, ops.begin() + j);
+                const int rows = outerRows(chain.back()->getOutput());
+                // 一行的工作集：每个被切分的张量各计一次
+                std::unordered_set<TensorObj *> touched;
+                size_t rowBytes = 0;
+                auto touch = [&](const Tensor &t)
+                {
+                    if (touched.insert(t.get()).second)
+                        rowBytes += t->getBytes() / t->getDims()[0];
+                };
+                for (auto &op : chain)
+                {
+                    auto split = *op->getTileSplit();
+                    for (size_t k = 0; k < split.size(); ++k)
+                        if (split[k])
+                            touch(op->getInputs(k));
+                    touch(op->getOutput());
+                }
+                const int tileRows = static_cast<int>(
+                    std::max<size_t>(1, tileBytes / std::max<size_t>(1, rowBytes)));
+                if (tileRows < rows)
+                    tileStreams.push_back({std::move(chain), tileRows});
+            }
+            i = j;
+        }
+    }
+
+    void GraphObj::buildSchedule()
+    {
+        schedule.clear();
+        tileViewOrigins.clear();
+        if (tileStreams.empty() && elidedOps.empty())
+            return;
+
+        std::unordered_map<OperatorObj *, const TileStream *> streamHeads;
+        std::unordered_set<OperatorObj *> streamed;
+        for (auto &stream : tileStreams)
+        {
+            streamHeads[stream.ops[0].get()] = &stream;
+            for (auto &op : stream.ops)
+                streamed.insert(op.get());
+        }
+
+        for (auto &op : ops)
+        {
+            if (elidedOps.count(op.get()) != 0)
+                continue;
+            if (streamed.count(op.get()) == 0)
+            {
+                schedule.emplace_back(op);
+                continue;
+            }
+            auto headIt = streamHeads.find(op.get());
+            if (headIt == streamHeads.end())
+                continue;
+
+            const auto &stream = *headIt->second;
+            std::unordered_set<TensorObj *> intermediates;
+            for (size_t i = 0; i + 1 < stream.ops.size(); ++i)
+                intermediates.insert(stream.ops[i]->getOutput().get());
+
+            const int rows = stream.ops.back()->getOutput()->getDims()[0];
+            for (int r0 = 0; r0 < rows; r0 += stream.rows)
+            {
+                const int n = std::min(stream.rows, rows - r0);
+                std::unordered_map<TensorObj *, Tensor> views;
+                auto viewOf = [&](const Tensor &t)
+                {
+                    auto &view = views[t.get()];
+                    if (!view)
+                    {
+                        Shape dims = t->getDims();
+                        const size_t rowBytes = t->getBytes() / dims[0];
+                        dims[0] = n;
+                        view = make_ref<TensorObj>(dims, t->getDType(), runtime);
+                        // 中间张量的每个 tile 都复用同一块 scratch
+                        size_t offset = 0;
+                        if (intermediates.count(t.get()) == 0)
+                            offset = r0 * rowBytes;
+                        view->setDataBlob(make_ref<BlobObj>(
+                            runtime, t->data->getPtr<char *>() + offset));
+                        tileViewOrigins[view.get()] = {t.get(), offset};
+                    }
+                    return view;
+                };
+                for (auto &chainOp : stream.ops)
+                {
+                    auto split = *chainOp->getTileSplit();
+                    TensorVec inputs;
+                    for (size_t k = 0; k < split.size(); ++k)
+                    {
+                        auto in = chainOp->getInputs(k);
+                        inputs.emplace_back(split[k] ? viewOf(in) : in);
+                    }
+                    schedule.emplace_back(
+                        chainOp->clone(inputs, {viewOf(chainOp->getOutput())}));
+                }
+            }
+        }
+    }
+
+    void GraphObj::symbolicDataMalloc()
+    {
+        IT_ASSERT(topo_sort() == true);
+        elidedOps.clear();
+        IT_ASSERT(states.empty(), "State tensors need dataMalloc");
+        for (auto &op : ops)
+        {
+            vector<SymShape> inputShapes;
+            for (auto &in : op->getInputs())
+                inputShapes.emplace_back(in->getSymShape());
+            auto ans = op->inferSymShape(inputShapes);
+            IT_ASSERT(ans.has_value(),
+                      "Symbolic shape inference failed: " + op->toString());
+            IT_ASSERT(ans->size() == op->getOutputs().size());
+            for (size_t i = 0; i < ans->size(); ++i)
+                op->getOutput(i)->setSymShape((*ans)[i]);
+        }
+
+        std::unordered_map<TensorObj *, int> remainingUses;
+        std::unordered_set<TensorObj *> keepAlive;
+        for (auto &t : tensors)
+        {
+            remainingUses[t.get()] = static_cast<int>(t->getNumTargets());
+            // 图输入（权重等）在多次运行间保持数据，不参与复用
+            if (isOutput(t.get()) || !t->getSourcePtr())
+                keepAlive.insert(t.get());
+        }
+
+        // 与 dataMalloc 相同的活跃区间分析，只是尺寸相同的 slot 才能复用
+        symSlots.clear();
+        symSlotOf.clear();
+        map<DimExpr, vector<size_t>> freeSlots;
+        auto assign = [&](const Tensor &t)
+        {
+            if (symSlotOf.count(t.get()) != 0)
+                return;
+            DimExpr bytes = static_cast<int>(t->getDType().getSize());
+            for (auto &d : t->getSymShape())
+                bytes = bytes * d;
+            auto &candidates = freeSlots[bytes];
+            if (!candidates.empty())
+            {
+                symSlotOf[t.get()] = candidates.back();
+                candidates.pop_back();
+                return;
+            }
+            symSlotOf[t.get()] = symSlots.size();
+            symSlots.emplace_back(bytes);
+        };
+
+        for (auto &t : getInputs())
+            assign(t);
+        for (auto &op : ops)
+        {
+            for (auto &out : op->getOutputs())
+                assign(out);
+            for (auto &in : op->getInputs())
+            {
+                auto *p = in.get();
+                if (--remainingUses[p] == 0 && keepAlive.count(p) == 0)
+                {
+                    const size_t slot = symSlotOf.at(p);
+                    freeSlots[symSlots[slot]].emplace_back(slot);
+                }
+            }
+            for (auto &out : op->getOutputs())
+            {
+                auto *p = out.get();
+                if (remainingUses[p] == 0 && keepAlive.count(p) == 0)
+                {
+                    const size_t slot = symSlotOf.at(p);
+                    freeSlots[symSlots[slot]].emplace_back(slot);
+                }
+            }
+        }
+
+        // 常量尺寸的 slot 排在前面，它们的偏移与符号取值无关
+        vector<size_t> order(symSlots.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                         { return symSlots[a].isConstant() &&
+                                  !symSlots[b].isConstant(); });
+        vector<size_t> rank(order.size());
+        vector<DimExpr> sorted;
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            rank[order[i]] = i;
+            sorted.emplace_back(symSlots[order[i]]);
+        }
+        symSlots = std::move(sorted);
+        for (auto &[t, slot] : symSlotOf)
+            slot = rank[slot];
+
+        tileStreams.clear();
+        schedule.clear();
+        tileViewOrigins.clear();
+        activePlan = nullptr;
+        symArena.reset();
+        symArenaBytes = 0;
+        // 形状未定，无法计时，使用默认 kernel
+        selectKernels(false);
+    }
+
+    void GraphObj::selectKernels(bool tune)
+    {
+        // 规划时按 (设备, 算子, 数据类型) 一次性选定 kernel，运行时不再查表
+        if (tune && tuner)
+        {
+            tuner->tune(*this);
+            return;
+        }
+        const auto &registry = KernelRegistry::getInstance();
+        for (auto &op : getSchedule())
+        {
+            auto records = registry.findKernelCandidates(
+                getKernelAttrs(runtime->getDevice(), op));
+            op->setKernel(records ? std::get<0>(records->front()) : nullptr);
+        }
+    }
+
+    void GraphObj::bindSymbols(const map<string, int> &values)
+    {
+        IT_ASSERT(!symSlots.empty(), "symbolicDataMalloc has not been called");
+        for (auto &t : tensors)
+        {
+            Shape dims;
+            for (auto &d : t->getSymShape())
+                dims.emplace_back(static_cast<int>(d.evaluate(values)));
+            if (dims != t->getDims())
+                t->setShape(dims);
+        }
+        // 重新推导以刷新算子缓存的 kernel 参数
+        for (auto &op : ops)
+            IT_ASSERT(op->inferShape().has_value());
+
+        const size_t alignment = sizeof(uint64_t);
+        vector<size_t> offsets(symSlots.size());
+        size_t total = 0, constantBytes = 0;
+        for (size_t i = 0; i < symSlots.size(); ++i)
+        {
+            offsets[i] = total;
+            const size_t bytes = symSlots[i].evaluate(values);
+            total += (bytes + alignment - 1) / alignment * alignment;
+            if (symSlots[i].isConstant())
+                constantBytes = total;
+        }
+        if (total > symArenaBytes)
+        {
+            auto rt = runtime;
+            std::shared_ptr<void> arena(runtime->alloc(total),
+                                        [rt](void *ptr) { rt->dealloc(ptr); });
+            if (symArena)
+                std::memcpy(arena.get(), symArena.get(), constantBytes);
+            symArena = std::move(arena);
+            symArenaBytes = total;
+        }
+
+        char *base = static_cast<char *>(symArena.get());
+        for (auto &t : tensors)
+        {
+            auto it = boundData.find(t.get());
+            void *ptr = it != boundData.end()
+                            ? it->second
+                            : base + offsets[symSlotOf.at(t.get())];
+            t->setDataBlob(make_ref<BlobObj>(runtime, ptr));
+        }
+    }
+
+    void GraphObj::setPlanCache(size_t capacity, vector<int> buckets)
+    {
+        planCapacity = capacity;
+        planBuckets = std::move(buckets);
+        std::sort(planBuckets.begin(), planBuckets.end());
+        plans.clear();
+        activePlan = nullptr;
+        baseInputShapes.clear();
+        // 输入（如权重）移出 arena，由所有形状未变的 plan 共享一份；
+        // 先拷贝再替换，旧的共享 buffer 可能正是数据来源
+        std::unordered_map<const TensorObj *, PlanInput> shared;
+        for (auto &t : getInputs())
+        {
+            baseInputShapes.emplace_back(t->getDims());
+            const bool isState =
+                std::any_of(states.begin(), states.end(),
+                            [&](const State &s) { return s.tensor == t; });
+            if (capacity == 0 || isState || boundData.count(t.get()) != 0 ||
+                t->data == nullptr)
+                continue;
+            auto rt = runtime;
+            std::shared_ptr<void> buffer(runtime->alloc(t->getBytes()),
+                                         [rt](void *ptr) { rt->dealloc(ptr); });
+            std::memcpy(buffer.get(), t->data->getPtr<void *>(), t->getBytes());
+            setExternalData(t, buffer.get());
+            shared[t.get()] = {t->getDims(), std::move(buffer)};
+        }
+        planInputs = std::move(shared);
+    }
+
+    vector<Shape> GraphObj::reshape(const vector<Shape> &inputShapes)
+    {
+        IT_ASSERT(planCapacity > 0, "Plan cache is disabled");
+        IT_ASSERT(!symArena, "Graph is bound to a symbolic plan");
+        auto inputs = getInputs();
+        IT_ASSERT(inputs.size() == inputShapes.size() &&
+                  inputs.size() == baseInputShapes.size());
+
+        // 与建图时不同的维度是动态维度，向上取整到 bucket
+        vector<Shape> key = inputShapes;
+        for (size_t i = 0; i < key.size(); ++i)
+        {
+            if (key[i].size() != baseInputShapes[i].size())
+                continue;
+            for (size_t d = 0; d < key[i].size(); ++d)
+            {
+                if (key[i][d] == baseInputShapes[i][d])
+                    continue;
+                auto it = std::lower_bound(planBuckets.begin(),
+                                           planBuckets.end(), key[i][d]);
+                if (it != planBuckets.end())
+                    key[i][d] = *it;
+            }
+        }
+
+        // 当前状态还不在缓存中（刚 dataMalloc 过）：先把它存为一个 plan
+        if (!activePlan)
+        {
+            vector<Shape> current;
+            for (auto &t : inputs)
+                current.emplace_back(t->getDims());
+            capturePlan(std::move(current));
+        }
+
+        for (auto it = plans.begin(); it != plans.end(); ++it)
+        {
+            if (it->key != key)
+                continue;
+            plans.splice(plans.begin(), plans, it);
+            activatePlan(plans.front());
+            return key;
+        }
+
+        // 未命中：重新推导形状并规划内存，形状不变的输入保留数据
+        auto previousArena = activePlan->arena;
+        vector<std::pair<Tensor, void *>> kept;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            // 共享 buffer 中的输入无需拷贝
+            auto shared = planInputs.find(inputs[i].get());
+            const bool isShared =
+                shared != planInputs.end() && shared->second.dims == key[i];
+            if (inputs[i]->getDims() != key[i])
+                inputs[i]->setShape(key[i]);
+            else if (!isShared)
+                kept.emplace_back(inputs[i], inputs[i]->data->getPtr<void *>());
+        }
+        shape_infer();
+        dataMalloc();
+        for (auto &[t, ptr] : kept)
+            std::memcpy(t->data->getPtr<void *>(), ptr, t->getBytes());
+        capturePlan(key);
+        return key;
+    }
+
+    void GraphObj::capturePlan(vector<Shape> key)
+    {
+        plans.remove_if([&](const Plan &plan) { return plan.key == key; });
+
+        Plan plan;
+        plan.key = std::move(key);
+        for (auto &t : tensors)
+        {
+            plan.shapes.emplace_back(t->getDims());
+            plan.blobs.emplace_back(t->data);
+        }
+        plan.arenaBytes = allocator.getPeak();
+        auto rt = runtime;
+        plan.arena = std::shared_ptr<void>(allocator.detach(),
+                                           [rt](void *ptr) { rt->dealloc(ptr); });
+        if (tileStreams.empty())
+        {
+            // clone 时会重新推导形状，算子缓存的 kernel 参数与本 plan 一致
+            for (auto &op : ops)
+                if (elidedOps.count(op.get()) == 0)
+                    plan.schedule.emplace_back(
+                        op->clone(op->getInputs(), op->getOutputs()));
+        }
+        else
+        {
+            plan.schedule = std::move(schedule);
+            tileStreams.clear();
+            schedule.clear();
+        }
+        plan.tileViewOrigins = std::move(tileViewOrigins);
+        tileViewOrigins.clear();
+
+        plans.emplace_front(std::move(plan));
+        while (plans.size() > planCapacity)
+            plans.pop_back();
+        activePlan = &plans.front();
+    }
+
+    void GraphObj::activatePlan(const Plan &plan)
+    {
+        IT_ASSERT(plan.shapes.size() == tensors.size(),
+                  "Tensors changed since the plan was made");
+        for (size_t i = 0; i < tensors.size(); ++i)
+        {
+            if (tensors[i]->getDims() != plan.shapes[i])
+                tensors[i]->setShape(plan.shapes[i]);
+            tensors[i]->setDataBlob(plan.blobs[i]);
+        }
+        activePlan = &plan;
+        for (auto &t : tensors)
+        {
+            auto it = boundData.find(t.get());
+            if (it != boundData.end())
+                setExternalData(t, it->second);
+        }
+    }
+
     Tensor GraphObj::addTensor(Shape dim, DataType dtype)
     {
-        return tensors.emplace_back(make_ref<TensorObj>(dim, dtype, runtime));
+        return tensors.emplace_back(
+            make_arena_ref<TensorObj>(arena, dim, dtype, runtime));
+    }
+
+    void GraphObj::beginBulkBuild()
+    {
+        IT_ASSERT(!bulkBuilding, "Already bulk building");
+        bulkBuilding = true;
+    }
+
+    Tensor GraphObj::addDeferredTensor(DataType dtype)
+    {
+        IT_ASSERT(bulkBuilding);
+        auto tensor = addTensor(Shape{}, dtype);
+        deferredTensors.insert(tensor.get());
+        return tensor;
+    }
+
+    void GraphObj::finalize()
+    {
+        IT_ASSERT(bulkBuilding, "finalize() without beginBulkBuild()");
+        bulkBuilding = false;
+        // 录入的算子尚未连接，一次性建立所有连接后排序
+        connectAll();
+        IT_ASSERT(topo_sort() == true);
+        for (auto &op : ops)
+        {
+            auto shapes = op->inferShape();
+            IT_ASSERT(shapes && shapes->size() == op->getOutputs().size(),
+                      "Invalid op " + op->toString());
+            for (size_t i = 0; i < shapes->size(); ++i)
+            {
+                auto &output = op->getOutputs()[i];
+                if (deferredTensors.erase(output.get()) != 0)
+                    output->setShape((*shapes)[i]);
+                else
+                    IT_ASSERT(output->getDims() == (*shapes)[i],
+                              "Output shape mismatch of op " + op->toString());
+            }
+        }
+        deferredTensors.clear();
+    }
+
+    Tensor GraphObj::addSymTensor(const SymShape &dim, DataType dtype)
+    {
+        // 以 1 代入所有符号，只用于建图时的形状检查
+        map<string, int> ones;
+        for (auto &d : dim)
+            for (auto &symbol : d.getSymbols())
+                ones[symbol] = 1;
+        Shape dims;
+        for (auto &d : dim)
+            dims.emplace_back(static_cast<int>(d.evaluate(ones)));
+        auto tensor = addTensor(dims, dtype);
+        tensor->setSymShape(dim);
+        return tensor;
+    }
+
+    void GraphObj::bindData(const Tensor &tensor, void *ptr)
+    {
+        IT_ASSERT(std::find(tensors.begin(), tensors.end(), tensor) !=
+                      tensors.end(),
+                  "Tensor is not in the graph");
+        IT_ASSERT(!tensor->getSourcePtr() || tensor->getNumTargets() == 0,
+                  "Only graph inputs and outputs can be bound");
+        for (auto &state : states)
+            IT_ASSERT(state.tensor != tensor, "State tensors can not be bound");
+        if (ptr == nullptr)
+        {
+            boundData.erase(tensor.get());
+            return;
+        }
+        IT_ASSERT(reinterpret_cast<uintptr_t>(ptr) %
+                          tensor->getDType().getSize() ==
+                      0,
+                  "Bound buffer is misaligned");
+        boundData[tensor.get()] = ptr;
+        setExternalData(tensor, ptr);
+    }
+
+    void GraphObj::setExternalData(const Tensor &tensor, void *ptr)
+    {
+        tensor->setDataBlob(make_ref<BlobObj>(runtime, ptr));
+        for (auto &op : getSchedule())
+        {
+            for (auto *list : {&op->getInputs(), &op->getOutputs()})
+                for (auto &t : *list)
+                {
+                    // 切片本身也可能有 tile view，递归重新指向
+                    auto origin = getTileViewOrigin(t.get());
+                    if (origin && origin->first == tensor.get())
+                        setExternalData(t, static_cast<char *>(ptr) + origin->second);
+                }
+        }
+    }
+
+    Tensor GraphObj::addState(Shape dim, DataType dtype, int axis, int capacity)
+    {
+        IT_ASSERT(axis >= 0 && axis < static_cast<int>(dim.size()));
+        IT_ASSERT(dim[axis] <= capacity);
+        for (int i = 0; i < axis; ++i)
+            IT_ASSERT(dim[i] == 1, "Dims before the state axis must be 1");
+
+        auto tensor = addTensor(dim, dtype);
+        Shape full = dim;
+        full[axis] = capacity;
+        size_t bytes = dtype.getSize();
+        for (auto d : full)
+            bytes *= d;
+        auto rt = runtime;
+        std::shared_ptr<void> buffer(runtime->alloc(bytes),
+                                     [rt](void *ptr) { rt->dealloc(ptr); });
+        tensor->setDataBlob(make_ref<BlobObj>(runtime, buffer.get()));
+        states.push_back({tensor, axis, capacity, dim[axis], std::move(buffer)});
+        return tensor;
+    }
+
+    int GraphObj::appendedRows(const State &state) const
+    {
+        int rows = 0, appends = 0;
+        for (auto *op : state.tensor->getTargetPtrs())
+        {
+            if (op->getOpType() != OpType::Append ||
+                op->getInputs(0) != state.tensor)
+                continue;
+            rows += op->getInputs(1)->getDims()[state.axis];
+            ++appends;
+        }
+        IT_ASSERT(appends <= 1, "A state can be appended by one op only");
+        return rows;
+    }
+
+    bool GraphObj::advanceStates()
+    {
+        // 先提交本轮追加的行，下一轮是否放得下单独报告
+        for (auto &state : states)
+        {
+            auto dims = state.tensor->getDims();
+            dims[state.axis] += appendedRows(state);
+            IT_ASSERT(dims[state.axis] <= state.capacity,
+                      "State capacity exceeded");
+            state.tensor->setShape(dims);
+        }
+        shape_infer();
+        return !statesFull();
+    }
+
+    bool GraphObj::statesFull() const
+    {
+        for (auto &state : states)
+            if (state.tensor->getDims()[state.axis] + appendedRows(state) >
+                state.capacity)
+                return true;
+        return false;
+    }
+
+    void GraphObj::resetStates()
+    {
+        for (auto &state : states)
+        {
+            auto dims = state.tensor->getDims();
+            dims[state.axis] = state.initialLength;
+            state.tensor->setShape(dims);
+        }
+        shape_infer();
     }
 
     Tensor GraphObj::addTensor(const Tensor &tensor)
@@ -402,36 +1539,40 @@ namespace infini
     // "predecessors" and "successors" of an operator of "ops" must be in "ops".
     bool GraphObj::checkValid() const
     {
-        for (auto tensor : tensors)
+        std::unordered_set<const OperatorObj *> opSet;
+        std::unordered_set<const TensorObj *> tensorSet;
+        for (auto &op : ops)
+            opSet.insert(op.get());
+        for (auto &tensor : tensors)
+            tensorSet.insert(tensor.get());
+        for (auto &tensor : tensors)
         {
-            IT_ASSERT(!(tensor->getTargets().size() == 0 &&
-                        nullptr == tensor->getSource()));
-            for (auto op : tensor->getTargets())
+            IT_ASSERT(!(tensor->getNumTargets() == 0 &&
+                        nullptr == tensor->getSourcePtr()));
+            for (auto *op : tensor->getTargetPtrs())
             {
-                IT_ASSERT(std::find(ops.begin(), ops.end(), op) != ops.end());
+                IT_ASSERT(opSet.count(op) != 0);
             }
-            auto op = tensor->getSource();
-            IT_ASSERT(!(op && std::find(ops.begin(), ops.end(), op) == ops.end()));
+            auto *op = tensor->getSourcePtr();
+            IT_ASSERT(!(op && opSet.count(op) == 0));
         }
-        for (auto op : ops)
+        for (auto &op : ops)
         {
-            for (auto tensor : op->getInputs())
+            for (auto &tensor : op->getInputs())
             {
-                IT_ASSERT(std::find(tensors.begin(), tensors.end(), tensor) !=
-                          tensors.end());
+                IT_ASSERT(tensorSet.count(tensor.get()) != 0);
             }
-            for (auto tensor : op->getOutputs())
+            for (auto &tensor : op->getOutputs())
             {
-                IT_ASSERT(std::find(tensors.begin(), tensors.end(), tensor) !=
-                          tensors.end());
+                IT_ASSERT(tensorSet.count(tensor.get()) != 0);
             }
-            for (auto pre : op->getPredecessors())
+            for (auto *pre : op->getPredecessorPtrs())
             {
-                IT_ASSERT(std::find(ops.begin(), ops.end(), pre) != ops.end());
+                IT_ASSERT(opSet.count(pre) != 0);
             }
-            for (auto suc : op->getSuccessors())
+            for (auto *suc : op->getSuccessorPtrs())
             {
-                IT_ASSERT(std::find(ops.begin(), ops.end(), suc) != ops.end());
+                IT_ASSERT(opSet.count(suc) != 0);
             }
         }
         std::set<UidBaseType> s;
@@ -0,0 +1,176 @@
+#include "core/kernel_tuner.h"
+#include "core/graph.h"
+#include "core/kernel.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace infini
+{
+    KernelTuner::KernelTuner(string cacheFile_, int repeats_)
+        : cacheFile(std::move(cacheFile_)), repeats(repeats_)
+    {
+        IT_ASSERT(repeats > 0);
+        if (cacheFile.empty())
+            return;
+        std::ifstream in(cacheFile);
+        string key, name;
+        while (in >> key >> name)
+            winners[key] = name;
+    }
+
+    string KernelTuner::signature(const Operator &op, Device device)
+    {
+        // No spaces, one result per line in the cache file
+        std::ostringstream os;
+        os << static_cast<int>(device) << ':' << op->getOpType().toString();
+        // Attributes such as a permutation or an axis change the work done
+        os << '{';
+        auto attrs = op->getOpAttrVector();
+        for (size_t i = 0; i < attrs.size(); ++i)
+            os << (i ? "," : "") << attrs[i];
+        os << '}';
+        auto append = [&](const TensorVec &tensors)
+        {
+            for (auto &t : tensors)
+            {
+                os << ':' << t->getDType().toString() << '[';
+                for (size_t i = 0; i < t->getRank(); ++i)
+                    os << (i ? "," : "") << t->getDims()[i];
+                os << ']';
+            }
+        };
+        append(op->getInputs());
+        os << "->";
+        append(op->getOutputs());
+        return os.str();
+    }
+
+    // Copies of the tensors with zero-filled buffers of their own, allocated
+    // into `buffers`
+    static TensorVec scratchTensors(const TensorVec &tensors,
+                                    vector<std::pair<Runtime, void *>> &buffers)
+    {
+        TensorVec ret;
+        for (auto &t : tensors)
+        {
+            auto runtime = t->getRuntime();
+            const size_t bytes = std::max<size_t>(t->getBytes(), 1);
+            void *ptr = runtime->alloc(bytes);
+            buffers.emplace_back(runtime, ptr);
+            std::memset(ptr, 0, bytes);
+            auto scratch = make_ref<TensorObj>(t->getDims(), t->getDType(), runtime);
+            scratch->setDataBlob(make_ref<BlobObj>(runtime, ptr));
+            ret.emplace_back(std::move(scratch));
+        }
+        return ret;
+    }
+
+    Kernel *KernelTuner::select(const Operator &op, const RuntimeObj *runtime)
+    {
+        bool timed;
+        return select(op, runtime, timed);
+    }
+
+    Kernel *KernelTuner::select(const Operator &op, const RuntimeObj *runtime,
+                                bool &timed)
+    {
+        timed = false;
+        const auto device = runtime->getDevice();
+        auto records = KernelRegistry::getInstance().findKernelCandidates(
+            getKernelAttrs(device, op));
+        if (!records)
+            return nullptr;
+        // The default and the candidates computing the same results compete
+        vector<const KernelRegistry::KernelRecord *> candidates;
+        for (auto &record : *records)
+            if (candidates.empty() || std::get<0>(record)->isTunable())
+                candidates.emplace_back(&record);
+        if (candidates.size() == 1)
+            return std::get<0>(*candidates.front());
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const string key = signature(op, device);
+        auto it = winners.find(key);
+        if (it != winners.end())
+        {
+            for (auto *record : candidates)
+                if (std::get<1>(*record) == it->second)
+                    return std::get<0>(*record);
+            // The winner is no longer registered, time again
+        }
+
+        // The candidates run on a copy of the op with scratch tensors: the
+        // inputs may not be filled in yet, and the outputs may be buffers
+        // bound by the caller
+        vector<std::pair<Runtime, void *>> buffers;
+        const auto scratch =
+            op->clone(scratchTensors(op->getInputs(), buffers),
+                      scratchTensors(op->getOutputs(), buffers));
+        Kernel *best = nullptr;
+        const string *bestName = nullptr;
+        double bestTime = 0;
+        for (auto *record : candidates)
+        {
+            Kernel *kernel = std::get<0>(*record);
+            double time = 0;
+            try
+            {
+                // Warm up once, then keep the fastest run
+                kernel->compute(scratch, runtime);
+                for (int i = 0; i < repeats; ++i)
+                {
+                    auto begin = std::chrono::steady_clock::now();
+                    kernel->compute(scratch, runtime);
+                    std::chrono::duration<double> elapsed =
+                        std::chrono::steady_clock::now() - begin;
+                    time = i ? std::min(time, elapsed.count()) : elapsed.count();
+                }
+            }
+            catch (const Exception &)
+            {
+                // The candidate does not support this op, e.g. its dtype
+                continue;
+            }
+            if (!best || time < bestTime)
+            {
+                best = kernel;
+                bestName = &std::get<1>(*record);
+                bestTime = time;
+            }
+        }
+        for (auto &[owner, ptr] : buffers)
+            owner->dealloc(ptr);
+        IT_ASSERT(best != nullptr,
+                  "No kernel can run " + op->getOpType().toString());
+        winners[key] = *bestName;
+        timed = true;
+        return best;
+    }
+
+    void KernelTuner::tune(GraphObj &graph)
+    {
+        bool changed = false;
+        const RuntimeObj *runtime = graph.getRuntime().get();
+        for (auto &op : graph.getSchedule())
+        {
+            bool timed;
+            op->setKernel(select(op, runtime, timed));
+            changed |= timed;
+        }
+        if (changed)
+            save();
+    }
+
+    void KernelTuner::save()
+    {
+        if (cacheFile.empty())
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ofstream out(cacheFile);
+        IT_ASSERT(out.good(), "Cannot write kernel tuning cache " + cacheFile);
+        for (auto &[key, name] : winners)
+            out << key << ' ' << name << '\n';
+    }
+
+} // namespace infini
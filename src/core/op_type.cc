@@ -21,6 +21,16 @@ namespace infini
             CASE(Transpose);
             CASE(Concat);
             CASE(MatMul);
+            CASE(QuantizeLinear);
+            CASE(DequantizeLinear);
+            CASE(QLinearMatMul);
+            CASE(MatMulNBits);
+            CASE(Append);
+            CASE(Gelu);
+            CASE(Silu);
+            CASE(Sigmoid);
+            CASE(Tanh);
+            CASE(Exp);
 
         default:
             return "Unknown";
@@ -7,41 +7,97 @@ namespace infini
     OperatorObj::OperatorObj(OpType opType, TensorVec inputs, TensorVec outputs)
         : type(opType), inputs(inputs), outputs(outputs) {}
 
-    void OperatorObj::removePredecessors(const Operator &op)
+    optional<vector<SymShape>>
+    OperatorObj::inferSymShape(const vector<SymShape> &inputs) const
     {
-        for (auto it = predecessors.begin(); it != predecessors.end();)
-        {
-            if (it->lock() == op)
-                it = predecessors.erase(it);
-            else
-                ++it;
-        }
+        for (const auto &shape : inputs)
+            for (const auto &d : shape)
+                if (!d.isConstant())
+                    return std::nullopt;
+        // Constant inputs have the shapes the graph was built with
+        vector<SymShape> ret;
+        for (const auto &t : outputs)
+            ret.emplace_back(t->getSymShape());
+        return ret;
     }
 
-    void OperatorObj::removeSuccessors(const Operator &op)
+    OperatorObj::~OperatorObj()
     {
-        for (auto it = successors.begin(); it != successors.end();)
-        {
-            if (it->lock() == op)
-                it = successors.erase(it);
-            else
-                ++it;
-        }
+        for (auto &input : inputs)
+            if (input)
+                input->removeTarget(this);
+        for (auto &output : outputs)
+            if (output && output->source == this)
+                output->source = nullptr;
+        disconnect();
+    }
+
+    OpVec OperatorObj::getPredecessors() const
+    {
+        OpVec ret;
+        ret.reserve(predecessors.size());
+        for (auto *op : predecessors)
+            ret.emplace_back(op->shared_from_this());
+        return ret;
+    }
+
+    OpVec OperatorObj::getSuccessors() const
+    {
+        OpVec ret;
+        ret.reserve(successors.size());
+        for (auto *op : successors)
+            ret.emplace_back(op->shared_from_this());
+        return ret;
+    }
+
+    void OperatorObj::removePredecessors(const OperatorObj *op)
+    {
+        predecessors.erase(
+            std::remove(predecessors.begin(), predecessors.end(), op),
+            predecessors.end());
+    }
+
+    void OperatorObj::removeSuccessors(const OperatorObj *op)
+    {
+        successors.erase(std::remove(successors.begin(), successors.end(), op),
+                         successors.end());
+    }
+
+    void OperatorObj::disconnect()
+    {
+        for (auto *pred : predecessors)
+            pred->removeSuccessors(this);
+        for (auto *succ : successors)
+            succ->removePredecessors(this);
+        predecessors.clear();
+        successors.clear();
     }
 
     void OperatorObj::replaceInput(Tensor t1, Tensor t2)
     {
+        if (t1 == t2)
+            return;
         for (auto itr = inputs.begin(); itr != inputs.end(); ++itr)
         {
             if (*itr == t1)
             {
                 *itr = t2;
+                t1->removeTarget(this);
+                t2->addTarget(this);
             }
         }
     }
 
     bool OperatorObj::checkValid(GraphObj *graph)
     {
+        if (graph && graph->isBulkBuilding())
+        { // shapes are inferred and checked by GraphObj::finalize
+            auto dataTypes = inferDataType();
+            for (size_t i = 0; i < outputs.size(); i++)
+                if (!outputs[i])
+                    outputs[i] = graph->addDeferredTensor(dataTypes[i]);
+            return true;
+        }
         auto optShapes = inferShape();
         if (!optShapes) // shape inference failed
             return false;
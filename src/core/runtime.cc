@@ -1,5 +1,6 @@
 #include "core/runtime.h"
 #include "core/blob.h"
+#include "core/execution_context.h"
 #include "core/kernel.h"
 #include "core/graph.h"
 #include "core/kernel.h"
@@ -11,15 +12,27 @@ namespace infini
     void NativeCpuRuntimeObj::run(const Graph &graph) const
     {
         const auto &kernelRegistry = KernelRegistry::getInstance();
+        IT_ASSERT(!graph->statesFull(),
+                  "State capacity exceeded, resetStates() first");
 
-        for (auto &op : graph->getOperators())
+        for (auto &op : graph->getSchedule())
         {
-            auto kernelAttrs = KernelAttrs{device, op->getOpType().underlying()};
-            Kernel *kernel = kernelRegistry.getKernel(kernelAttrs);
+            Kernel *kernel = op->getKernel();
+            if (!kernel)
+                kernel = kernelRegistry.getKernel(getKernelAttrs(device, op));
             kernel->compute(op, this);
         }
     }
 
+    void RuntimeObj::run(const Graph &graph,
+                         const Ref<ExecutionContextObj> &ctx) const
+    {
+        IT_ASSERT(ctx->getGraph() == graph,
+                  "ExecutionContext belongs to another graph");
+        ExecutionContextObj::Scope scope(ctx.get());
+        run(graph);
+    }
+
     string NativeCpuRuntimeObj::toString() const { return "CPU Runtime"; }
 
     void NativeCpuRuntimeObj::dealloc(void *ptr)
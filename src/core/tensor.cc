@@ -1,5 +1,6 @@
 #include "core/tensor.h"
 #include "core/blob.h"
+#include "core/execution_context.h"
 #include "core/operator.h"
 #include "core/runtime.h"
 #include <cstring>
@@ -24,16 +25,48 @@ namespace infini {
                      ", dtype " + dtype.toString() + ", " + runtime->toString() +
                      ", " + ss.str() + "\n";
         vector<UidBaseType> targetGuids;
-        for (const auto &op : targets)
-            targetGuids.emplace_back(op.lock()->getGuid());
-        if (auto o = source.lock())
-            ret += ", source " + std::to_string(o->getGuid());
+        for (const auto *op : targets)
+            targetGuids.emplace_back(op->getGuid());
+        if (source)
+            ret += ", source " + std::to_string(source->getGuid());
         else
             ret += ", source None";
         ret += ", targets " + vecToString(targetGuids);
         return ret;
     }
 
+    OpVec TensorObj::getTargets() const
+    {
+        OpVec ret;
+        ret.reserve(targets.size());
+        for (auto *op : targets)
+            ret.emplace_back(op->shared_from_this());
+        return ret;
+    }
+
+    Operator TensorObj::getSource() const
+    {
+        return source ? source->shared_from_this() : nullptr;
+    }
+
+SymShape TensorObj::getSymShape() const {
+    if (!symShape.empty())
+        return symShape;
+    return SymShape(shape.begin(), shape.end());
+}
+
+void TensorObj::setSymShape(SymShape shape_) {
+    IT_ASSERT(shape_.size() == shape.size(), "Symbolic shape rank mismatch");
+    bool symbolic = std::any_of(shape_.begin(), shape_.end(),
+                                [](const DimExpr &d) { return !d.isConstant(); });
+    symShape = symbolic ? std::move(shape_) : SymShape{};
+}
+
+void *TensorObj::contextDataPtr() const {
+    auto *ctx = ExecutionContextObj::current();
+    return ctx ? ctx->resolve(this) : nullptr;
+}
+
 void TensorObj::setShape(Shape shape_) {
     shape = shape_;
     size_t size = std::accumulate(shape.begin(), shape.end(), 1,
@@ -0,0 +1,23 @@
+#include "operators/append.h"
+#include "core/kernel.h"
+
+namespace infini {
+
+// The output aliases the state, whose dims before the axis are all 1, so the
+// new rows go right after the current contents.
+class NaiveAppend : public CpuKernelWithoutConfig {
+    void compute(const Operator &_op,
+                 const RuntimeObj *context) const override {
+        auto op = as<AppendObj>(_op);
+        auto state = op->getInputs(0), input = op->getInputs(1);
+        auto outPtr = op->getOutput()->getRawDataPtr<char *>();
+        IT_ASSERT(state->getRawDataPtr<char *>() == outPtr,
+                  "Append output must share the state buffer");
+        std::memcpy(outPtr + state->getBytes(),
+                    input->getRawDataPtr<char *>(), input->getBytes());
+    }
+};
+
+REGISTER_KERNEL(Device::CPU, OpType::Append, NaiveAppend, "AppendNaive_CPU");
+
+} // namespace infini
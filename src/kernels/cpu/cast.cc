@@ -0,0 +1,382 @@
+#include "operators/unary.h"
+#include "core/kernel.h"
+#include "utils/cpu_features.h"
+#include "utils/float16.h"
+#include <limits>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace infini
+{
+    // Converts one value, saturating when the destination is a narrower
+    // integer type. NaN converts to 0.
+    template <typename D, typename S>
+    static D saturate_cast(S val)
+    {
+        if constexpr (std::is_floating_point_v<S> && std::is_integral_v<D>)
+        {
+            if (val != val)
+                return 0;
+            // (S)max may round up (e.g. 2^31 for int32), so compare with >=
+            if (val >= static_cast<S>(std::numeric_limits<D>::max()))
+                return std::numeric_limits<D>::max();
+            if (val <= static_cast<S>(std::numeric_limits<D>::lowest()))
+                return std::numeric_limits<D>::lowest();
+            return static_cast<D>(val);
+        }
+        else if constexpr (std::is_integral_v<S> && std::is_integral_v<D>)
+        {
+            static_assert(sizeof(S) < sizeof(int64_t) || std::is_signed_v<S>,
+                          "Source must be representable in int64_t");
+            const int64_t wide = static_cast<int64_t>(val);
+            const int64_t lo = static_cast<int64_t>(std::numeric_limits<D>::lowest());
+            const int64_t hi =
+                static_cast<int64_t>(std::min<uint64_t>(std::numeric_limits<D>::max(),
+                                                        std::numeric_limits<int64_t>::max()));
+            return static_cast<D>(std::min(std::max(wide, lo), hi));
+        }
+        else
+        {
+            return static_cast<D>(val);
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    // Vector bodies: each converts a prefix of the input whose length is a
+    // multiple of 8 and returns its length. The caller finishes the tail with
+    // the scalar conversion, which gives bit-identical results.
+
+    __attribute__((target("avx2,f16c"))) static size_t
+    fp32ToFp16F16c(const float *src, uint16_t *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                        _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2,f16c"))) static size_t
+    fp16ToFp32F16c(const uint16_t *src, float *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    fp32ToBf16Avx2(const float *src, uint16_t *dst, size_t n)
+    {
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i roundingBias = _mm256_set1_epi32(0x7FFF);
+        const __m256i absMask = _mm256_set1_epi32(0x7FFFFFFF);
+        const __m256i inf = _mm256_set1_epi32(0x7F800000);
+        const __m256i quietBit = _mm256_set1_epi32(0x0040);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            __m256i upper = _mm256_srli_epi32(x, 16);
+            __m256i lsb = _mm256_and_si256(upper, one);
+            __m256i rounded = _mm256_srli_epi32(
+                _mm256_add_epi32(x, _mm256_add_epi32(roundingBias, lsb)), 16);
+            __m256i isNan = _mm256_cmpgt_epi32(_mm256_and_si256(x, absMask), inf);
+            __m256i res = _mm256_blendv_epi8(
+                rounded, _mm256_or_si256(upper, quietBit), isNan);
+            __m256i packed = _mm256_permute4x64_epi64(
+                _mm256_packus_epi32(res, res), 0xD8);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                             _mm256_castsi256_si128(packed));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    bf16ToFp32Avx2(const uint16_t *src, float *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            __m256i x = _mm256_slli_epi32(_mm256_cvtepu16_epi32(b), 16);
+            _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(x));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    fp32ToInt32Avx2(const float *src, int32_t *dst, size_t n)
+    {
+        // cvttps yields INT32_MIN for NaN and out-of-range values, which is
+        // already right for large negative inputs.
+        const __m256 overflow = _mm256_set1_ps(2147483648.f);
+        const __m256i maxVal = _mm256_set1_epi32(std::numeric_limits<int32_t>::max());
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256 v = _mm256_loadu_ps(src + i);
+            __m256i r = _mm256_cvttps_epi32(v);
+            r = _mm256_blendv_epi8(
+                r, maxVal, _mm256_castps_si256(_mm256_cmp_ps(v, overflow, _CMP_GE_OQ)));
+            r = _mm256_andnot_si256(
+                _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)), r);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), r);
+        }
+        return i;
+    }
+
+    // Clamps 8 floats into [lo, hi] with NaN mapped to 0, then truncates.
+    __attribute__((target("avx2"))) static inline __m256i
+    clampTruncate(__m256 v, __m256 lo, __m256 hi)
+    {
+        v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+        return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(v, lo), hi));
+    }
+
+    // Packs 8 int32 into 8 int16 with signed saturation.
+    __attribute__((target("avx2"))) static inline __m128i packInt16(__m256i r)
+    {
+        return _mm256_castsi256_si128(
+            _mm256_permute4x64_epi64(_mm256_packs_epi32(r, r), 0xD8));
+    }
+
+    // Packs 8 int32 into 8 int8 with signed saturation, in the low 64 bits.
+    __attribute__((target("avx2"))) static inline __m128i packInt8(__m256i r)
+    {
+        __m256i p = _mm256_packs_epi32(r, r);
+        p = _mm256_packs_epi16(p, p);
+        p = _mm256_permutevar8x32_epi32(p, _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+        return _mm256_castsi256_si128(p);
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    fp32ToInt16Avx2(const float *src, int16_t *dst, size_t n)
+    {
+        const __m256 lo = _mm256_set1_ps(-32768.f), hi = _mm256_set1_ps(32767.f);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i r = clampTruncate(_mm256_loadu_ps(src + i), lo, hi);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packInt16(r));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    fp32ToInt8Avx2(const float *src, int8_t *dst, size_t n)
+    {
+        const __m256 lo = _mm256_set1_ps(-128.f), hi = _mm256_set1_ps(127.f);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i r = clampTruncate(_mm256_loadu_ps(src + i), lo, hi);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i), packInt8(r));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    int32ToInt16Avx2(const int32_t *src, int16_t *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packInt16(r));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    int32ToInt8Avx2(const int32_t *src, int8_t *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i), packInt8(r));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    int32ToFp32Avx2(const int32_t *src, float *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(r));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    int16ToFp32Avx2(const int16_t *src, float *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(r)));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    int8ToFp32Avx2(const int8_t *src, float *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i r = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(r)));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) static size_t
+    uint8ToFp32Avx2(const uint8_t *src, float *dst, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i r = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(r)));
+        }
+        return i;
+    }
+
+#define SIMD_IF(feature, fn) (CpuFeatures::get().feature ? fn : nullptr)
+#else
+#define SIMD_IF(feature, fn) nullptr
+#endif
+
+    class NativeCast : public CpuKernelWithoutConfig
+    {
+        template <typename S, typename D, typename F>
+        static void castWith(const Operator &op, F &&convert,
+                             size_t (*simd)(const S *, D *, size_t) = nullptr)
+        {
+            IT_ASSERT(op->getInputs(0)->getDType().getSize() == sizeof(S),
+                      "Cast input data type mismatch");
+            auto src = op->getInputs(0)->getRawDataPtr<S *>();
+            auto dst = op->getOutput()->getRawDataPtr<D *>();
+            auto n = op->getOutput()->size();
+            size_t i = simd ? simd(src, dst, n) : 0;
+            for (; i < n; ++i)
+                dst[i] = convert(src[i]);
+        }
+
+        template <typename S, typename D>
+        static void cast(const Operator &op,
+                         size_t (*simd)(const S *, D *, size_t) = nullptr)
+        {
+            castWith<S, D>(op, saturate_cast<D, S>, simd);
+        }
+
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            auto op = as<CastObj>(_op);
+            switch (op->getType())
+            {
+            case CastType::Float2Float16:
+                castWith<float, uint16_t>(op, fp32_to_fp16,
+                                          SIMD_IF(f16c, fp32ToFp16F16c));
+                break;
+            case CastType::Float162Float:
+                castWith<uint16_t, float>(op, fp16_to_fp32,
+                                          SIMD_IF(f16c, fp16ToFp32F16c));
+                break;
+            case CastType::Float2BFloat16:
+                castWith<float, uint16_t>(op, fp32_to_bf16,
+                                          SIMD_IF(avx2, fp32ToBf16Avx2));
+                break;
+            case CastType::BFloat162Float:
+                castWith<uint16_t, float>(op, bf16_to_fp32,
+                                          SIMD_IF(avx2, bf16ToFp32Avx2));
+                break;
+            case CastType::Float2Int64:
+                cast<float, int64_t>(op);
+                break;
+            case CastType::Float2Int32:
+                cast<float, int32_t>(op, SIMD_IF(avx2, fp32ToInt32Avx2));
+                break;
+            case CastType::Float2Int16:
+                cast<float, int16_t>(op, SIMD_IF(avx2, fp32ToInt16Avx2));
+                break;
+            case CastType::Float2Int8:
+                cast<float, int8_t>(op, SIMD_IF(avx2, fp32ToInt8Avx2));
+                break;
+            case CastType::Int322Float:
+                cast<int32_t, float>(op, SIMD_IF(avx2, int32ToFp32Avx2));
+                break;
+            case CastType::Int322Int8:
+                cast<int32_t, int8_t>(op, SIMD_IF(avx2, int32ToInt8Avx2));
+                break;
+            case CastType::Int322Int16:
+                cast<int32_t, int16_t>(op, SIMD_IF(avx2, int32ToInt16Avx2));
+                break;
+            case CastType::Int322Int64:
+                cast<int32_t, int64_t>(op);
+                break;
+            case CastType::Int162Float:
+                cast<int16_t, float>(op, SIMD_IF(avx2, int16ToFp32Avx2));
+                break;
+            case CastType::Int162Int32:
+                cast<int16_t, int32_t>(op);
+                break;
+            case CastType::Int82Float:
+                cast<int8_t, float>(op, SIMD_IF(avx2, int8ToFp32Avx2));
+                break;
+            case CastType::Int82Int16:
+                cast<int8_t, int16_t>(op);
+                break;
+            case CastType::Int82Int32:
+                cast<int8_t, int32_t>(op);
+                break;
+            case CastType::Uint82Float:
+                cast<uint8_t, float>(op, SIMD_IF(avx2, uint8ToFp32Avx2));
+                break;
+            case CastType::Uint82Int32:
+                cast<uint8_t, int32_t>(op);
+                break;
+            case CastType::Uint82Int64:
+                cast<uint8_t, int64_t>(op);
+                break;
+            case CastType::Int642Int32:
+                cast<int64_t, int32_t>(op);
+                break;
+            case CastType::Int642Uint32:
+                cast<int64_t, uint32_t>(op);
+                break;
+            case CastType::Int642Float:
+                cast<int64_t, float>(op);
+                break;
+            case CastType::Uint322Int64:
+                cast<uint32_t, int64_t>(op);
+                break;
+            case CastType::Float2Float:
+                cast<float, float>(op);
+                break;
+            default:
+                IT_TODO_HALT();
+            }
+        }
+    };
+
+#undef SIMD_IF
+
+    REGISTER_KERNEL(Device::CPU, OpType::Cast, NativeCast, "Cast_CPU");
+
+}; // namespace infini
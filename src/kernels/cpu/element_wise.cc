@@ -1,9 +1,12 @@
 #include "operators/element_wise.h"
 #include "core/kernel.h"
+#include "utils/float16.h"
 #include "utils/operator_utils.h"
 
 namespace infini
 {
+    // Registered once per dtype, N being the index of the dtype
+    template <int N>
     class NativeElementWise : public CpuKernelWithoutConfig
     {
         template <typename T>
@@ -30,9 +33,12 @@ namespace infini
             return (T)(val0 / val1);
         }
 
-        template <typename T>
-        void doCompute(const Operator &_op, const RuntimeObj *context) const
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
         {
+            using Traits = DTCompute<N>;
+            using T = typename Traits::storage;
+            using C = typename Traits::compute;
             auto op = as<ElementWiseObj>(_op);
             T *inptr0 = op->getInputs(0)->getRawDataPtr<T *>();
             T *inptr1 = op->getInputs(1)->getRawDataPtr<T *>();
@@ -63,21 +69,21 @@ namespace infini
             Shape strideB = getStride(b);
 
             auto n = op->getOutput()->size();
-            T (*_doCompute)
-            (T val0, T val1);
+            C (*_doCompute)
+            (C val0, C val1);
             switch (op->getOpType().underlying())
             {
             case OpType::Add:
-                _doCompute = addCompute<T>;
+                _doCompute = addCompute<C>;
                 break;
             case OpType::Sub:
-                _doCompute = subCompute<T>;
+                _doCompute = subCompute<C>;
                 break;
             case OpType::Mul:
-                _doCompute = mulCompute<T>;
+                _doCompute = mulCompute<C>;
                 break;
             case OpType::Div:
-                _doCompute = divCompute<T>;
+                _doCompute = divCompute<C>;
                 break;
             default:
                 IT_TODO_HALT();
@@ -88,32 +94,18 @@ namespace infini
                 auto shapeIndexC = locate_index(i, shapeC);
                 auto indexA = delocate_index(shapeIndexC, a, strideA);
                 auto indexB = delocate_index(shapeIndexC, b, strideB);
-                outptr[i] = _doCompute(inptr0[indexA], inptr1[indexB]);
-            }
-        }
-
-        void compute(const Operator &_op,
-                     const RuntimeObj *context) const override
-        {
-#define CASE(N) \
-    case N:     \
-        doCompute<DT<N>::t>(_op, context)
-
-            int dataTypeIdx = _op->getDType().getIndex();
-            switch (dataTypeIdx)
-            {
-                CASE(1); // DataType::Float32
-                break;
-                CASE(12); // DataType::UInt32
-                break;
-            default:
-                IT_TODO_HALT();
+                outptr[i] = Traits::store(_doCompute(Traits::load(inptr0[indexA]),
+                                                     Traits::load(inptr1[indexB])));
             }
         }
     };
 
-    REGISTER_KERNEL(Device::CPU, OpType::Add, NativeElementWise, "addNaive_CPU");
-    REGISTER_KERNEL(Device::CPU, OpType::Sub, NativeElementWise, "subNaive_CPU");
-    REGISTER_KERNEL(Device::CPU, OpType::Mul, NativeElementWise, "mulNaive_CPU");
-    REGISTER_KERNEL(Device::CPU, OpType::Div, NativeElementWise, "divNaive_CPU");
+#define REGISTER_ELEMENT_WISE(opType, name)                                 \
+    REGISTER_TYPED_KERNELS(Device::CPU, opType, NativeElementWise, name,      \
+                           CPU_COMPUTE_DTYPES)
+
+    REGISTER_ELEMENT_WISE(OpType::Add, "addNaive_CPU");
+    REGISTER_ELEMENT_WISE(OpType::Sub, "subNaive_CPU");
+    REGISTER_ELEMENT_WISE(OpType::Mul, "mulNaive_CPU");
+    REGISTER_ELEMENT_WISE(OpType::Div, "divNaive_CPU");
 }; // namespace infini
@@ -0,0 +1,94 @@
+#include "operators/matmul.h"
+#include "core/kernel.h"
+#include "utils/float16.h"
+#include "utils/operator_utils.h"
+
+namespace infini
+{
+    // With Parallel, the output rows of all batches are spread over threads
+    template <int N, bool Parallel>
+    class NaiveMatmul : public CpuKernelWithoutConfig
+    {
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            using Traits = DTCompute<N>;
+            using T = typename Traits::storage;
+            using C = typename Traits::compute;
+            auto op = as<MatmulObj>(_op);
+            T *aPtr = op->getInputs(0)->getRawDataPtr<T *>();
+            T *bPtr = op->getInputs(1)->getRawDataPtr<T *>();
+            T *cPtr = op->getOutput()->getRawDataPtr<T *>();
+            const int m = op->getM(), n = op->getN(), k = op->getK();
+            const bool transA = op->getTransA(), transB = op->getTransB();
+
+            // Leading dims are broadcast batch dims
+            auto batchOf = [](const Shape &dims)
+            { return Shape(dims.begin(), dims.end() - 2); };
+            Shape outBatch = batchOf(op->getOutput()->getDims());
+            const auto rank = outBatch.size();
+            auto expand = [&](const Shape &batch)
+            {
+                Shape expanded(rank, 1);
+                std::copy(batch.begin(), batch.end(),
+                          expanded.begin() + (rank - batch.size()));
+                return expanded;
+            };
+            auto getStride = [&](const Shape &shape)
+            {
+                int p = 1;
+                Shape stride(rank);
+                for (auto i = rank; i > 0; --i)
+                {
+                    stride[i - 1] = p;
+                    p = p * shape[i - 1];
+                }
+                return stride;
+            };
+            Shape aBatch = expand(batchOf(op->getInputs(0)->getDims()));
+            Shape bBatch = expand(batchOf(op->getInputs(1)->getDims()));
+            Shape strideA = getStride(aBatch), strideB = getStride(bBatch);
+            size_t batches = 1;
+            for (auto d : outBatch)
+                batches *= d;
+
+            // Accumulate one output row in the compute type, row-major over B
+            const long rows = static_cast<long>(batches) * m;
+#pragma omp parallel if (Parallel)
+            {
+                vector<C> row(n);
+#pragma omp for
+                for (long r = 0; r < rows; ++r)
+                {
+                    const size_t batch = r / m;
+                    const int i = r % m;
+                    auto index = locate_index(batch, outBatch);
+                    const T *a = aPtr + delocate_index(index, aBatch, strideA) * m * k;
+                    const T *b = bPtr + delocate_index(index, bBatch, strideB) * k * n;
+                    T *c = cPtr + batch * m * n;
+                    std::fill(row.begin(), row.end(), C(0));
+                    for (int p = 0; p < k; ++p)
+                    {
+                        const C aVal = Traits::load(transA ? a[p * m + i] : a[i * k + p]);
+                        for (int j = 0; j < n; ++j)
+                            row[j] += aVal * Traits::load(transB ? b[j * k + p]
+                                                                 : b[p * n + j]);
+                    }
+                    for (int j = 0; j < n; ++j)
+                        c[i * n + j] = Traits::store(row[j]);
+                }
+            }
+        }
+    };
+
+    template <int N>
+    using SerialMatmul = NaiveMatmul<N, false>;
+    template <int N>
+    using ParallelMatmul = NaiveMatmul<N, true>;
+
+    REGISTER_TYPED_KERNELS(Device::CPU, OpType::MatMul, SerialMatmul,
+                           "MatmulNaive_CPU", CPU_COMPUTE_DTYPES);
+    REGISTER_TYPED_KERNELS(Device::CPU, OpType::MatMul, ParallelMatmul,
+                           "MatmulParallel_CPU", CPU_COMPUTE_DTYPES);
+
+}; // namespace infini
@@ -0,0 +1,147 @@
+#include "operators/matmul_nbits.h"
+#include "core/kernel.h"
+#include "utils/cpu_features.h"
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace infini
+{
+    // Dot product of len Float32 activations with one group of packed
+    // weights, len being a multiple of 16. The group scale is applied by the
+    // caller.
+    using GroupDot = float (*)(const float *, const uint8_t *, int);
+
+    static float groupDotInt8(const float *a, const uint8_t *q, int len)
+    {
+        float acc = 0;
+        for (int p = 0; p < len; ++p)
+            acc += a[p] * static_cast<int8_t>(q[p]);
+        return acc;
+    }
+
+    static float groupDotInt4(const float *a, const uint8_t *q, int len)
+    {
+        float acc = 0;
+        for (int p = 0; p < len; p += 16, q += 8)
+            for (int j = 0; j < 8; ++j)
+            {
+                acc += a[p + j] * ((q[j] & 0xF) - 8);
+                acc += a[p + j + 8] * ((q[j] >> 4) - 8);
+            }
+        return acc;
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2"))) static inline float hsum(__m256 acc)
+    {
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc),
+                                _mm256_extractf128_ps(acc, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+        return _mm_cvtss_f32(sum);
+    }
+
+    // Weights are widened to int32 and converted to float in registers, so
+    // the dequantized matrix is never materialized.
+    __attribute__((target("avx2,fma"))) static float
+    groupDotInt8Avx2(const float *a, const uint8_t *q, int len)
+    {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        for (int p = 0; p < len; p += 16)
+        {
+            __m256i lo = _mm256_cvtepi8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i *>(q + p)));
+            __m256i hi = _mm256_cvtepi8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i *>(q + p + 8)));
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + p),
+                                   _mm256_cvtepi32_ps(lo), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + p + 8),
+                                   _mm256_cvtepi32_ps(hi), acc1);
+        }
+        return hsum(_mm256_add_ps(acc0, acc1));
+    }
+
+    // Every 8 bytes hold 16 values: the low nibbles are values 0..7 and the
+    // high nibbles values 8..15, so both halves line up with contiguous
+    // activations.
+    __attribute__((target("avx2,fma"))) static float
+    groupDotInt4Avx2(const float *a, const uint8_t *q, int len)
+    {
+        const __m256i mask = _mm256_set1_epi32(0xF), offset = _mm256_set1_epi32(8);
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        for (int p = 0; p < len; p += 16, q += 8)
+        {
+            __m256i v = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i *>(q)));
+            __m256i lo = _mm256_sub_epi32(_mm256_and_si256(v, mask), offset);
+            __m256i hi = _mm256_sub_epi32(_mm256_srli_epi32(v, 4), offset);
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + p),
+                                   _mm256_cvtepi32_ps(lo), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + p + 8),
+                                   _mm256_cvtepi32_ps(hi), acc1);
+        }
+        return hsum(_mm256_add_ps(acc0, acc1));
+    }
+#endif
+
+    static GroupDot selectGroupDot(int bits)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        const auto &cpu = CpuFeatures::get();
+        if (cpu.avx2 && cpu.fma)
+            return bits == 8 ? groupDotInt8Avx2 : groupDotInt4Avx2;
+#endif
+        return bits == 8 ? groupDotInt8 : groupDotInt4;
+    }
+
+    class MatMulNBits : public CpuKernelWithoutConfig
+    {
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            auto op = as<MatMulNBitsObj>(_op);
+            const int m = op->getM(), n = op->getN(), k = op->getK();
+            const int groupSize = op->getGroupSize();
+            const int groups = (k + groupSize - 1) / groupSize;
+            const int groupBytes = groupSize * op->getBits() / 8;
+            const int kPad = groups * groupSize;
+            const float *aPtr = op->getInputs(0)->getRawDataPtr<float *>();
+            const uint8_t *bPtr = op->getInputs(1)->getRawDataPtr<uint8_t *>();
+            const float *scales = op->getInputs(2)->getRawDataPtr<float *>();
+            float *cPtr = op->getOutput()->getRawDataPtr<float *>();
+
+            // The padded tail of the last group is zero in B; pad A to match
+            // so every group is processed whole.
+            vector<float> aPad;
+            if (kPad != k)
+            {
+                aPad.assign(size_t(m) * kPad, 0.f);
+                for (int i = 0; i < m; ++i)
+                    std::memcpy(&aPad[size_t(i) * kPad], aPtr + size_t(i) * k,
+                                k * sizeof(float));
+                aPtr = aPad.data();
+            }
+
+            auto dot = selectGroupDot(op->getBits());
+#pragma omp parallel for collapse(2)
+            for (int i = 0; i < m; ++i)
+                for (int j = 0; j < n; ++j)
+                {
+                    const float *a = aPtr + size_t(i) * kPad;
+                    const uint8_t *q = bPtr + size_t(j) * groups * groupBytes;
+                    const float *s = scales + size_t(j) * groups;
+                    float acc = 0;
+                    for (int g = 0; g < groups; ++g)
+                        acc += s[g] * dot(a + g * groupSize, q + g * groupBytes,
+                                          groupSize);
+                    cPtr[size_t(i) * n + j] = acc;
+                }
+        }
+    };
+
+    REGISTER_KERNEL(Device::CPU, OpType::MatMulNBits, MatMulNBits,
+                    "MatMulNBits_CPU");
+
+}; // namespace infini
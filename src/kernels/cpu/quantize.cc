@@ -0,0 +1,374 @@
+#include "operators/quantize.h"
+#include "core/kernel.h"
+#include "utils/cpu_features.h"
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace infini
+{
+    // Quantization parameters are indexed by channel: element i belongs to
+    // channel (i / inner) % channels.
+    static void getChannelLayout(const Operator &op, int axis, size_t &channels,
+                                 size_t &inner)
+    {
+        channels = op->getInputs(1)->size();
+        inner = op->getInputs(0)->size();
+        if (channels == 1)
+            return;
+        const auto &dims = op->getInputs(0)->getDims();
+        inner = 1;
+        for (size_t i = axis + 1; i < dims.size(); ++i)
+            inner *= dims[i];
+    }
+
+    template <typename Q>
+    static Q saturateRound(float val)
+    {
+        // nearbyint rounds half to even in the default rounding mode
+        val = std::nearbyint(val);
+        val = std::min<float>(std::max<float>(val, std::numeric_limits<Q>::lowest()),
+                              std::numeric_limits<Q>::max());
+        return static_cast<Q>(val);
+    }
+
+    class QuantizeLinear : public CpuKernelWithoutConfig
+    {
+        template <typename Q>
+        void doCompute(const Operator &_op, const RuntimeObj *context) const
+        {
+            auto op = as<QuantizeLinearObj>(_op);
+            float *inptr = op->getInputs(0)->getRawDataPtr<float *>();
+            float *scale = op->getInputs(1)->getRawDataPtr<float *>();
+            Q *zeroPoint = op->getInputs(2)->getRawDataPtr<Q *>();
+            Q *outptr = op->getOutput()->getRawDataPtr<Q *>();
+            size_t channels, inner;
+            getChannelLayout(op, op->getAxis(), channels, inner);
+
+            auto n = op->getOutput()->size();
+            for (size_t i = 0; i < n; ++i)
+            {
+                const size_t c = (i / inner) % channels;
+                outptr[i] = saturateRound<Q>(inptr[i] / scale[c] + zeroPoint[c]);
+            }
+        }
+
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            if (_op->getOutDType() == DataType::Int8)
+                doCompute<int8_t>(_op, context);
+            else if (_op->getOutDType() == DataType::UInt8)
+                doCompute<uint8_t>(_op, context);
+            else
+                IT_TODO_HALT();
+        }
+    };
+
+    class DequantizeLinear : public CpuKernelWithoutConfig
+    {
+        template <typename Q>
+        void doCompute(const Operator &_op, const RuntimeObj *context) const
+        {
+            auto op = as<DequantizeLinearObj>(_op);
+            Q *inptr = op->getInputs(0)->getRawDataPtr<Q *>();
+            float *scale = op->getInputs(1)->getRawDataPtr<float *>();
+            Q *zeroPoint = op->getInputs(2)->getRawDataPtr<Q *>();
+            float *outptr = op->getOutput()->getRawDataPtr<float *>();
+            size_t channels, inner;
+            getChannelLayout(op, op->getAxis(), channels, inner);
+
+            auto n = op->getOutput()->size();
+            for (size_t i = 0; i < n; ++i)
+            {
+                const size_t c = (i / inner) % channels;
+                outptr[i] = static_cast<float>(int(inptr[i]) - int(zeroPoint[c])) *
+                            scale[c];
+            }
+        }
+
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            if (_op->getDType() == DataType::Int8)
+                doCompute<int8_t>(_op, context);
+            else if (_op->getDType() == DataType::UInt8)
+                doCompute<uint8_t>(_op, context);
+            else
+                IT_TODO_HALT();
+        }
+    };
+
+    // Dot products of a tile of 2 u8 rows of A by 4 s8 columns of B, each
+    // kPad long with kPad a multiple of 32. Row r of the tile starts at
+    // a + r * kPad and column c at b + c * kPad; out is row-major. Every
+    // operand loaded is used for 2 or 4 products.
+    using TileU8S8 = void (*)(const uint8_t *, const int8_t *, int, int32_t *);
+
+    static void tileU8S8(const uint8_t *a, const int8_t *b, int kPad,
+                         int32_t *out)
+    {
+        for (int r = 0; r < 2; ++r)
+            for (int c = 0; c < 4; ++c)
+            {
+                int32_t acc = 0;
+                for (int p = 0; p < kPad; ++p)
+                    acc += int32_t(a[r * kPad + p]) * int32_t(b[c * kPad + p]);
+                out[r * 4 + c] = acc;
+            }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2"))) static inline void
+    storeTile(const __m256i (&acc)[2][4], int32_t *out)
+    {
+        for (int r = 0; r < 2; ++r)
+        {
+            // Reduce the 4 accumulators of a row into one vector of 4 sums
+            __m256i s01 = _mm256_hadd_epi32(acc[r][0], acc[r][1]);
+            __m256i s23 = _mm256_hadd_epi32(acc[r][2], acc[r][3]);
+            __m256i s = _mm256_hadd_epi32(s01, s23);
+            __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(s),
+                                        _mm256_extracti128_si256(s, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + r * 4), sum);
+        }
+    }
+
+    // pmaddubsw would saturate u8 * s8 pair sums to int16, so widen both
+    // operands to int16 and use pmaddwd, which is exact.
+    __attribute__((target("avx2"))) static void
+    tileU8S8Avx2(const uint8_t *a, const int8_t *b, int kPad, int32_t *out)
+    {
+        __m256i acc[2][4];
+        for (auto &row : acc)
+            for (auto &v : row)
+                v = _mm256_setzero_si256();
+        for (int p = 0; p < kPad; p += 16)
+        {
+            __m256i va[2], vb[4];
+            for (int r = 0; r < 2; ++r)
+                va[r] = _mm256_cvtepu8_epi16(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(a + r * kPad + p)));
+            for (int c = 0; c < 4; ++c)
+                vb[c] = _mm256_cvtepi8_epi16(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(b + c * kPad + p)));
+            for (int r = 0; r < 2; ++r)
+                for (int c = 0; c < 4; ++c)
+                    acc[r][c] = _mm256_add_epi32(
+                        acc[r][c], _mm256_madd_epi16(va[r], vb[c]));
+        }
+        storeTile(acc, out);
+    }
+
+#define TILE_U8S8_DPBUSD(name, isa, dpbusd)                                    \
+    __attribute__((target(isa))) static void                                   \
+    name(const uint8_t *a, const int8_t *b, int kPad, int32_t *out)            \
+    {                                                                          \
+        __m256i acc[2][4];                                                     \
+        for (auto &row : acc)                                                  \
+            for (auto &v : row)                                                \
+                v = _mm256_setzero_si256();                                    \
+        for (int p = 0; p < kPad; p += 32)                                     \
+        {                                                                      \
+            __m256i va[2], vb[4];                                              \
+            for (int r = 0; r < 2; ++r)                                        \
+                va[r] = _mm256_loadu_si256(                                    \
+                    reinterpret_cast<const __m256i *>(a + r * kPad + p));      \
+            for (int c = 0; c < 4; ++c)                                        \
+                vb[c] = _mm256_loadu_si256(                                    \
+                    reinterpret_cast<const __m256i *>(b + c * kPad + p));      \
+            for (int r = 0; r < 2; ++r)                                        \
+                for (int c = 0; c < 4; ++c)                                    \
+                    acc[r][c] = dpbusd(acc[r][c], va[r], vb[c]);               \
+        }                                                                      \
+        storeTile(acc, out);                                                   \
+    }
+
+    TILE_U8S8_DPBUSD(tileU8S8AvxVnni, "avx2,avxvnni", _mm256_dpbusd_avx_epi32)
+    TILE_U8S8_DPBUSD(tileU8S8Avx512Vnni, "avx2,avx512vnni,avx512vl",
+                     _mm256_dpbusd_epi32)
+#undef TILE_U8S8_DPBUSD
+#endif
+
+    static TileU8S8 selectTileU8S8()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        const auto &cpu = CpuFeatures::get();
+        if (cpu.avx512vnni)
+            return tileU8S8Avx512Vnni;
+        if (cpu.avxvnni)
+            return tileU8S8AvxVnni;
+        if (cpu.avx2)
+            return tileU8S8Avx2;
+#endif
+        return tileU8S8;
+    }
+
+    class QLinearMatMul : public CpuKernelWithoutConfig
+    {
+        using PackedWeights = QLinearMatMulObj::PackedWeights;
+
+        // The integer core multiplies u8 rows of A by s8 columns of B.
+        // Signed A is shifted by +128 and unsigned B by -128; the shifts
+        // are folded into the zero points:
+        //   sum (a - za)(b - zb) = sum a'b' - za' colsum(b') - zb' rowsum(a')
+        //                          + k za' zb'
+        template <typename TB>
+        static std::shared_ptr<const PackedWeights>
+        packWeights(const Ref<QLinearMatMulObj> &op)
+        {
+            const int n = op->getN(), k = op->getK();
+            const int kPad = (k + 31) / 32 * 32, nPad = (n + 3) / 4 * 4;
+            const int shiftB = std::is_signed_v<TB> ? 0 : 128;
+            const int perColumn = op->getInputs(4)->size() == 1 ? 0 : 1;
+            TB *bPtr = op->getInputs(3)->getRawDataPtr<TB *>();
+            TB *bZero = op->getInputs(5)->getRawDataPtr<TB *>();
+
+            auto packed = std::make_shared<PackedWeights>();
+            packed->b = bPtr;
+            packed->bZeroPoint = bZero;
+            packed->kPad = kPad;
+            // Column-major, so that both operands are contiguous in k
+            packed->data.assign(size_t(nPad) * kPad, 0);
+            packed->colSum.assign(n, 0);
+            packed->zb.resize(n);
+            for (int p = 0; p < k; ++p)
+                for (int j = 0; j < n; ++j)
+                {
+                    const int8_t v = int8_t(int(bPtr[p * n + j]) - shiftB);
+                    packed->data[size_t(j) * kPad + p] = v;
+                    packed->colSum[j] += v;
+                }
+            for (int j = 0; j < n; ++j)
+                packed->zb[j] = int32_t(bZero[j * perColumn]) - shiftB;
+            return packed;
+        }
+
+        // The packed weights of the op, repacked if B is computed by the
+        // graph or its buffers moved since they were packed.
+        template <typename TB>
+        static std::shared_ptr<const PackedWeights>
+        getWeights(const Ref<QLinearMatMulObj> &op)
+        {
+            const auto &b = op->getInputs(3), &bZero = op->getInputs(5);
+            if (b->getSourcePtr() || bZero->getSourcePtr())
+                return packWeights<TB>(op);
+            auto packed = op->getPackedWeights();
+            if (!packed || packed->b != b->getRawDataPtr<void *>() ||
+                packed->bZeroPoint != bZero->getRawDataPtr<void *>())
+            {
+                packed = packWeights<TB>(op);
+                op->setPackedWeights(packed);
+            }
+            return packed;
+        }
+
+        template <typename TA, typename TB>
+        void doCompute(const Operator &_op, const RuntimeObj *context) const
+        {
+            auto op = as<QLinearMatMulObj>(_op);
+            const int m = op->getM(), n = op->getN(), k = op->getK();
+            const auto weights = getWeights<TB>(op);
+            const int kPad = weights->kPad;
+            const int mPad = (m + 1) / 2 * 2, nPad = (n + 3) / 4 * 4;
+            TA *aPtr = op->getInputs(0)->getRawDataPtr<TA *>();
+            const float aScale = *op->getInputs(1)->getRawDataPtr<float *>();
+            const TA aZero = *op->getInputs(2)->getRawDataPtr<TA *>();
+            float *bScale = op->getInputs(4)->getRawDataPtr<float *>();
+            const float yScale = *op->getInputs(6)->getRawDataPtr<float *>();
+            const auto yType = op->getOutDType();
+            const int perColumn = op->getInputs(4)->size() == 1 ? 0 : 1;
+
+            // A changes every run; its scratch is kept per thread so that
+            // repeated runs do not allocate. Padding in k meets the zero
+            // padding of B, and the padding row is never stored.
+            const int shiftA = std::is_signed_v<TA> ? 128 : 0;
+            static thread_local vector<uint8_t> a;
+            static thread_local vector<int32_t> rowSum;
+            static thread_local vector<float> multiplier;
+            a.resize(size_t(mPad) * kPad);
+            rowSum.assign(mPad, 0);
+            for (int i = 0; i < m; ++i)
+            {
+                uint8_t *row = &a[size_t(i) * kPad];
+                for (int p = 0; p < k; ++p)
+                {
+                    row[p] = uint8_t(int(aPtr[i * k + p]) + shiftA);
+                    rowSum[i] += row[p];
+                }
+                std::fill(row + k, row + kPad, 0);
+            }
+            const int32_t za = int32_t(aZero) + shiftA;
+            multiplier.resize(n);
+            for (int j = 0; j < n; ++j)
+                multiplier[j] = aScale * bScale[j * perColumn] / yScale;
+
+            const auto tile = selectTileU8S8();
+            const int8_t *bt = weights->data.data();
+            const int32_t *colSum = weights->colSum.data(), *zb = weights->zb.data();
+            const uint8_t *aPacked = a.data();
+            const int32_t *rowSums = rowSum.data();
+            const float *multipliers = multiplier.data();
+            // Blocks of nBlock columns by mBlock rows: the 4 columns of a
+            // tile stay in L1 while the rows of the block stream past them.
+            const int nBlock = 64, mBlock = 32;
+            auto requantize = [&](auto *yPtr)
+            {
+                using TY = std::remove_pointer_t<decltype(yPtr)>;
+                const int32_t yZero = *op->getInputs(7)->getRawDataPtr<TY *>();
+#pragma omp parallel for collapse(2) schedule(static)
+                for (int jb = 0; jb < nPad; jb += nBlock)
+                    for (int ib = 0; ib < mPad; ib += mBlock)
+                        for (int j = jb; j < std::min(jb + nBlock, nPad); j += 4)
+                            for (int i = ib; i < std::min(ib + mBlock, mPad); i += 2)
+                            {
+                                int32_t dots[8];
+                                tile(aPacked + size_t(i) * kPad,
+                                     bt + size_t(j) * kPad, kPad, dots);
+                                for (int r = 0; r < 2 && i + r < m; ++r)
+                                    for (int c = 0; c < 4 && j + c < n; ++c)
+                                    {
+                                        const int col = j + c;
+                                        const int32_t acc =
+                                            dots[r * 4 + c] - za * colSum[col] -
+                                            zb[col] * rowSums[i + r] +
+                                            k * za * zb[col];
+                                        yPtr[size_t(i + r) * n + col] =
+                                            saturateRound<TY>(acc * multipliers[col] +
+                                                              yZero);
+                                    }
+                            }
+            };
+            if (yType == DataType::Int8)
+                requantize(op->getOutput()->getRawDataPtr<int8_t *>());
+            else
+                requantize(op->getOutput()->getRawDataPtr<uint8_t *>());
+        }
+
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            const bool aSigned = _op->getInputs(0)->getDType() == DataType::Int8;
+            const bool bSigned = _op->getInputs(3)->getDType() == DataType::Int8;
+            if (aSigned && bSigned)
+                doCompute<int8_t, int8_t>(_op, context);
+            else if (aSigned)
+                doCompute<int8_t, uint8_t>(_op, context);
+            else if (bSigned)
+                doCompute<uint8_t, int8_t>(_op, context);
+            else
+                doCompute<uint8_t, uint8_t>(_op, context);
+        }
+    };
+
+    REGISTER_KERNEL(Device::CPU, OpType::QuantizeLinear, QuantizeLinear,
+                    "QuantizeLinear_CPU");
+    REGISTER_KERNEL(Device::CPU, OpType::DequantizeLinear, DequantizeLinear,
+                    "DequantizeLinear_CPU");
+    REGISTER_KERNEL(Device::CPU, OpType::QLinearMatMul, QLinearMatMul,
+                    "QLinearMatMul_CPU");
+
+}; // namespace infini
@@ -14,9 +14,10 @@ inline Shape idx2Pos(const Shape &shape, size_t idx) {
     return pos;
 }
 
-class NaiveTranspose : public CpuKernelWithoutConfig {
-    template <typename T>
-    void doCompute(const Operator &_op, const RuntimeObj *context) const {
+template <int N> class NaiveTranspose : public CpuKernelWithoutConfig {
+    void compute(const Operator &_op,
+                 const RuntimeObj *context) const override {
+        using T = typename DT<N>::t;
         auto op = as<TransposeObj>(_op);
         auto inputs = op->getInputs(), outputs = op->getOutputs();
         const auto &inDim = inputs[0]->getDims();
@@ -35,26 +36,70 @@ class NaiveTranspose : public CpuKernelWithoutConfig {
             outPtr[outIdx] = inPtr[inIdx];
         }
     }
+};
+
+// Walks the output in order with the input stride of every output dim. The
+// last two output dims are copied in square tiles so that the strided side
+// stays in cache, and the outer dims are spread over threads.
+template <int N> class TiledTranspose : public CpuKernelWithoutConfig {
+    static constexpr int tile = 32;
 
     void compute(const Operator &_op,
                  const RuntimeObj *context) const override {
-#define CASE(N)                                                                \
-    case N:                                                                    \
-        doCompute<DT<N>::t>(_op, context)
-
-        int dataTypeIdx = _op->getDType().getIndex();
-        switch (dataTypeIdx) {
-            CASE(1); // DataType::Float32
-            break;
-            CASE(12); // DataType::UInt32
-            break;
-        default:
-            IT_TODO_HALT();
+        using T = typename DT<N>::t;
+        auto op = as<TransposeObj>(_op);
+        const auto &inDim = op->getInputs(0)->getDims();
+        const auto &perm = op->getPermute();
+        const int rank = perm.size();
+
+        Shape inStride(rank), outDim(rank), stride(rank);
+        for (int i = rank - 1, p = 1; i >= 0; --i) {
+            inStride[i] = p;
+            p *= inDim[i];
+        }
+        for (int i = 0; i < rank; ++i) {
+            outDim[i] = inDim[perm[i]];
+            stride[i] = inStride[perm[i]];
+        }
+        // [outer..., rows, cols] of the output
+        const int outerRank = std::max(rank - 2, 0);
+        const int rows = rank >= 2 ? outDim[rank - 2] : 1;
+        const int cols = rank >= 1 ? outDim[rank - 1] : 1;
+        const size_t rowStride = rank >= 2 ? stride[rank - 2] : 0;
+        const size_t colStride = rank >= 1 ? stride[rank - 1] : 0;
+        long outer = 1;
+        for (int i = 0; i < outerRank; ++i)
+            outer *= outDim[i];
+
+        auto inPtr = op->getInputs(0)->getRawDataPtr<T *>(),
+             outPtr = op->getOutput()->getRawDataPtr<T *>();
+#pragma omp parallel for
+        for (long o = 0; o < outer; ++o) {
+            size_t base = 0;
+            for (long i = outerRank - 1, rest = o; i >= 0; --i) {
+                base += (rest % outDim[i]) * stride[i];
+                rest /= outDim[i];
+            }
+            const T *src = inPtr + base;
+            T *dst = outPtr + o * rows * cols;
+            for (int r0 = 0; r0 < rows; r0 += tile)
+                for (int c0 = 0; c0 < cols; c0 += tile) {
+                    const int r1 = std::min(r0 + tile, rows),
+                              c1 = std::min(c0 + tile, cols);
+                    for (int r = r0; r < r1; ++r)
+                        for (int c = c0; c < c1; ++c)
+                            dst[r * cols + c] =
+                                src[r * rowStride + c * colStride];
+                }
         }
     }
 };
 
-REGISTER_KERNEL(Device::CPU, OpType::Transpose, NaiveTranspose,
-                "TransposeNaive_CPU");
+#define REGISTER_TRANSPOSE(kernel, name)                                      \
+    REGISTER_TYPED_KERNELS(Device::CPU, OpType::Transpose, kernel, name,      \
+                           CPU_COPY_DTYPES)
+
+REGISTER_TRANSPOSE(NaiveTranspose, "TransposeNaive_CPU");
+REGISTER_TRANSPOSE(TiledTranspose, "TransposeTiled_CPU");
 
 } // namespace infini
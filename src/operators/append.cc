@@ -0,0 +1,45 @@
+#include "operators/append.h"
+#include "utils/operator_utils.h"
+
+namespace infini
+{
+    AppendObj::AppendObj(GraphObj *graph, Tensor state, Tensor input,
+                         Tensor output, int axis)
+        : OperatorObj(OpType::Append, {state, input}, {output})
+    {
+        this->axis = get_real_axis(axis, state->getRank());
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> AppendObj::inferShape(const TensorVec &inputs)
+    {
+        auto dims = inputs[0]->getDims();
+        const auto &rows = inputs[1]->getDims();
+        if (rows.size() != dims.size())
+            return std::nullopt;
+        for (size_t i = 0; i < dims.size(); ++i)
+            if (static_cast<int>(i) != axis && rows[i] != dims[i])
+                return std::nullopt;
+        dims[axis] += rows[axis];
+        return {{dims}};
+    }
+
+    std::string AppendObj::toString() const
+    {
+        std::ostringstream os;
+        os << type.toString() << "[" << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << vecToString(inputs[1]->getDims()) << ",";
+        os << "axis=" << axis << ",";
+        os << "state=" << inputs[0]->getGuid() << ",";
+        os << "input=" << inputs[1]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+    vector<int> AppendObj::getOpAttrVector() const
+    {
+        return {type.underlying(), axis};
+    }
+} // namespace infini
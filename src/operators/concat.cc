@@ -4,10 +4,9 @@
 namespace infini
 {
     ConcatObj::ConcatObj(GraphObj *graph, TensorVec inputs, Tensor output, int _dim)
-        : OperatorObj(OpType::Concat, inputs, {output})
+        : OperatorObj(OpType::Concat, inputs, {output}), dim(_dim)
     {
-        int rank = inputs[0]->getRank();
-        dim = get_real_axis(_dim, rank);
+        // dim is normalized by inferShape, once the rank is known
         IT_ASSERT(checkValid(graph));
     }
 
@@ -21,7 +20,7 @@ namespace infini
 
         IT_ASSERT(!inputs.empty());
         const int rank = static_cast<int>(inputs[0]->getRank());
-        IT_ASSERT(dim >= 0 && dim < rank);
+        dim = get_real_axis(dim, rank);
 
         int sumDim = dims[dim];
         for (size_t i = 1; i < inputs.size(); ++i)
@@ -41,6 +40,27 @@ namespace infini
         return {{dims}};
     }
 
+    optional<vector<SymShape>>
+    ConcatObj::inferSymShape(const vector<SymShape> &inputs) const
+    {
+        SymShape dims = inputs[0];
+        for (size_t i = 1; i < inputs.size(); ++i)
+        {
+            for (size_t r = 0; r < dims.size(); ++r)
+                if (static_cast<int>(r) != dim && inputs[i][r] != dims[r])
+                    return std::nullopt;
+            dims[dim] = dims[dim] + inputs[i][dim];
+        }
+        return {{dims}};
+    }
+
+    optional<vector<bool>> ConcatObj::getTileSplit() const
+    {
+        if (dim == 0)
+            return std::nullopt;
+        return vector<bool>(inputs.size(), true);
+    }
+
     std::string ConcatObj::toString() const
     {
         std::ostringstream os;
@@ -56,4 +76,9 @@ namespace infini
         return os.str();
     }
 
+    vector<int> ConcatObj::getOpAttrVector() const
+    {
+        return {type.underlying(), dim};
+    }
+
 } // namespace infini
@@ -17,6 +17,29 @@ namespace infini
         return {{res}};
     }
 
+    optional<vector<SymShape>>
+    ElementWiseObj::inferSymShape(const vector<SymShape> &inputs) const
+    {
+        auto res = infer_broadcast(inputs[0], inputs[1]);
+        if (!res)
+            return std::nullopt;
+        return {{*res}};
+    }
+
+    optional<vector<bool>> ElementWiseObj::getTileSplit() const
+    {
+        const auto &outDims = outputs[0]->getDims();
+        vector<bool> split;
+        for (const auto &input : inputs)
+        {
+            // Inputs broadcast along the outermost dimension are read whole
+            const auto &dims = input->getDims();
+            split.emplace_back(dims.size() == outDims.size() &&
+                               dims[0] == outDims[0]);
+        }
+        return split;
+    }
+
     std::string ElementWiseObj::toString() const
     {
         std::ostringstream os;
@@ -22,6 +22,32 @@ namespace infini
         return os.str();
     }
 
+    vector<int> MatmulObj::getOpAttrVector() const
+    {
+        return {type.underlying(), transA, transB};
+    }
+
+    optional<vector<bool>> MatmulObj::getTileSplit() const
+    {
+        const auto &outDims = outputs[0]->getDims();
+        if (outDims.size() == 2)
+        {
+            // Rows of C come from rows of A
+            if (transA)
+                return std::nullopt;
+            return vector<bool>{true, false};
+        }
+        // Batched matmul is split along the outermost batch dimension
+        vector<bool> split;
+        for (const auto &input : inputs)
+        {
+            const auto &dims = input->getDims();
+            split.emplace_back(dims.size() == outDims.size() &&
+                               dims[0] == outDims[0]);
+        }
+        return split;
+    }
+
     optional<vector<Shape>> MatmulObj::inferShape(const TensorVec &inputs)
     {
         // =================================== 作业 ===================================
@@ -60,4 +86,23 @@ namespace infini
         return {{out}};
     }
 
+    optional<vector<SymShape>>
+    MatmulObj::inferSymShape(const vector<SymShape> &inputs) const
+    {
+        const auto &aDims = inputs[0];
+        const auto &bDims = inputs[1];
+        auto outBatch = infer_broadcast(SymShape(aDims.begin(), aDims.end() - 2),
+                                        SymShape(bDims.begin(), bDims.end() - 2));
+        const auto &aK = transA ? aDims[aDims.size() - 2] : aDims[aDims.size() - 1];
+        const auto &bK = transB ? bDims[bDims.size() - 1] : bDims[bDims.size() - 2];
+        // K must match for every value of the symbols
+        if (!outBatch || aK != bK)
+            return std::nullopt;
+
+        SymShape out = *outBatch;
+        out.push_back(transA ? aDims[aDims.size() - 1] : aDims[aDims.size() - 2]);
+        out.push_back(transB ? bDims[bDims.size() - 2] : bDims[bDims.size() - 1]);
+        return {{out}};
+    }
+
 } // namespace infini
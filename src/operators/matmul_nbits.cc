@@ -0,0 +1,108 @@
+#include "operators/matmul_nbits.h"
+#include <cmath>
+
+namespace infini
+{
+
+    MatMulNBitsObj::MatMulNBitsObj(GraphObj *graph, Tensor A, Tensor B,
+                                   Tensor scales, Tensor C, int bits,
+                                   int groupSize)
+        : OperatorObj(OpType::MatMulNBits, TensorVec{A, B, scales}, {C}),
+          bits(bits), groupSize(groupSize)
+    {
+        IT_ASSERT(bits == 4 || bits == 8, "MatMulNBits supports 4 or 8 bits");
+        IT_ASSERT(groupSize > 0 && groupSize % 16 == 0,
+                  "MatMulNBits group size must be a multiple of 16");
+        IT_ASSERT(checkValid(graph));
+    }
+
+    string MatMulNBitsObj::toString() const
+    {
+        std::ostringstream os;
+        os << "MatMulNBits[" << getGuid() << "](bits=" << bits
+           << ",group=" << groupSize << ",A=" << inputs[0]->getGuid()
+           << ",B=" << inputs[1]->getGuid() << ",C=" << outputs[0]->getGuid()
+           << ",mnk=[" << m << "," << n << "," << k << "])";
+        return os.str();
+    }
+
+    vector<int> MatMulNBitsObj::getOpAttrVector() const
+    {
+        return {type.underlying(), bits, groupSize};
+    }
+
+    optional<vector<Shape>> MatMulNBitsObj::inferShape(const TensorVec &inputs)
+    {
+        const auto &A = inputs[0], &B = inputs[1], &scales = inputs[2];
+        if (A->getRank() < 2 || A->getDType() != DataType::Float32 ||
+            B->getDType() != DataType::UInt8 ||
+            scales->getDType() != DataType::Float32)
+            return std::nullopt;
+
+        auto dims = A->getDims();
+        k = dims.back();
+        m = A->size() / k;
+        n = B->getRank() == 3 ? B->getDims()[0] : 0;
+        if (B->getDims() != packedShape(k, n, bits, groupSize) ||
+            scales->getDims() != scalesShape(k, n, groupSize))
+            return std::nullopt;
+
+        dims.back() = n;
+        return {{dims}};
+    }
+
+    optional<vector<bool>> MatMulNBitsObj::getTileSplit() const
+    {
+        return vector<bool>{true, false, false};
+    }
+
+    Shape MatMulNBitsObj::packedShape(int k, int n, int bits, int groupSize)
+    {
+        return {n, (k + groupSize - 1) / groupSize, groupSize * bits / 8};
+    }
+
+    Shape MatMulNBitsObj::scalesShape(int k, int n, int groupSize)
+    {
+        return {n, (k + groupSize - 1) / groupSize};
+    }
+
+    void MatMulNBitsObj::packWeight(const float *b, int k, int n, int bits,
+                                    int groupSize, uint8_t *packed,
+                                    float *scales)
+    {
+        const int groups = (k + groupSize - 1) / groupSize;
+        const int groupBytes = groupSize * bits / 8;
+        const int maxQ = bits == 8 ? 127 : 7;
+        vector<int> q(groupSize);
+        for (int j = 0; j < n; ++j)
+        {
+            for (int g = 0; g < groups; ++g)
+            {
+                const int k0 = g * groupSize;
+                const int len = std::min(groupSize, k - k0);
+                float absMax = 0;
+                for (int p = 0; p < len; ++p)
+                    absMax = std::max(absMax, std::fabs(b[(k0 + p) * n + j]));
+                const float scale = absMax / maxQ;
+                scales[j * groups + g] = scale;
+                std::fill(q.begin(), q.end(), 0);
+                for (int p = 0; scale != 0 && p < len; ++p)
+                    q[p] = std::clamp<int>(std::nearbyint(b[(k0 + p) * n + j] / scale),
+                                           -maxQ - (bits == 4), maxQ);
+
+                uint8_t *dst = packed + (size_t(j) * groups + g) * groupBytes;
+                if (bits == 8)
+                {
+                    for (int p = 0; p < groupSize; ++p)
+                        dst[p] = static_cast<uint8_t>(static_cast<int8_t>(q[p]));
+                    continue;
+                }
+                for (int block = 0; block < groupSize; block += 16)
+                    for (int p = 0; p < 8; ++p)
+                        dst[block / 2 + p] = static_cast<uint8_t>(
+                            (q[block + p] + 8) | ((q[block + p + 8] + 8) << 4));
+            }
+        }
+    }
+
+} // namespace infini
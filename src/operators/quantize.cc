@@ -0,0 +1,198 @@
+#include "operators/quantize.h"
+#include "utils/operator_utils.h"
+
+namespace infini
+{
+    // Scale and zero point are either single values or 1-D along `axis`.
+    // The axis only matters in the latter case, where it is normalized here
+    // since the rank is not known at construction while bulk building.
+    static bool checkQuantParams(const TensorVec &inputs, int &axis)
+    {
+        const auto &scale = inputs[1], &zeroPoint = inputs[2];
+        if (scale->getDType() != DataType::Float32 ||
+            scale->getDims() != zeroPoint->getDims())
+            return false;
+        if (scale->size() == 1)
+            return true;
+        const auto &dims = inputs[0]->getDims();
+        const int rank = static_cast<int>(dims.size());
+        if (scale->getRank() != 1 || axis < -rank || axis >= rank)
+            return false;
+        axis = get_real_axis(axis, rank);
+        return scale->getDims()[0] == dims[axis];
+    }
+
+    static bool isInt8Type(DataType dtype)
+    {
+        return dtype == DataType::Int8 || dtype == DataType::UInt8;
+    }
+
+    QuantizeLinearObj::QuantizeLinearObj(GraphObj *graph, Tensor input,
+                                         Tensor scale, Tensor zeroPoint,
+                                         Tensor output, int axis)
+        : OperatorObj(OpType::QuantizeLinear, {input, scale, zeroPoint},
+                      {output}),
+          axis(axis)
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> QuantizeLinearObj::inferShape(const TensorVec &inputs)
+    {
+        if (inputs[0]->getDType() != DataType::Float32 ||
+            !isInt8Type(inputs[2]->getDType()) || !checkQuantParams(inputs, axis))
+            return std::nullopt;
+        return {{inputs[0]->getDims()}};
+    }
+
+    vector<DataType> QuantizeLinearObj::inferDataType(const TensorVec &inputs) const
+    {
+        return {inputs[2]->getDType()};
+    }
+
+    optional<vector<bool>> QuantizeLinearObj::getTileSplit() const
+    {
+        if (!isPerTensor() && axis == 0)
+            return std::nullopt;
+        return vector<bool>{true, false, false};
+    }
+
+    std::string QuantizeLinearObj::toString() const
+    {
+        std::ostringstream os;
+        os << type.toString() << "[" << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << "axis=" << axis << ",";
+        os << "input=" << inputs[0]->getGuid() << ",";
+        os << "scale=" << inputs[1]->getGuid() << ",";
+        os << "zero_point=" << inputs[2]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+    vector<int> QuantizeLinearObj::getOpAttrVector() const
+    {
+        return {type.underlying(), axis};
+    }
+
+    DequantizeLinearObj::DequantizeLinearObj(GraphObj *graph, Tensor input,
+                                             Tensor scale, Tensor zeroPoint,
+                                             Tensor output, int axis)
+        : OperatorObj(OpType::DequantizeLinear, {input, scale, zeroPoint},
+                      {output}),
+          axis(axis)
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>>
+    DequantizeLinearObj::inferShape(const TensorVec &inputs)
+    {
+        if (!isInt8Type(inputs[0]->getDType()) ||
+            inputs[0]->getDType() != inputs[2]->getDType() ||
+            !checkQuantParams(inputs, axis))
+            return std::nullopt;
+        return {{inputs[0]->getDims()}};
+    }
+
+    vector<DataType>
+    DequantizeLinearObj::inferDataType(const TensorVec &inputs) const
+    {
+        return {DataType::Float32};
+    }
+
+    optional<vector<bool>> DequantizeLinearObj::getTileSplit() const
+    {
+        if (!isPerTensor() && axis == 0)
+            return std::nullopt;
+        return vector<bool>{true, false, false};
+    }
+
+    std::string DequantizeLinearObj::toString() const
+    {
+        std::ostringstream os;
+        os << type.toString() << "[" << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << "axis=" << axis << ",";
+        os << "input=" << inputs[0]->getGuid() << ",";
+        os << "scale=" << inputs[1]->getGuid() << ",";
+        os << "zero_point=" << inputs[2]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+    vector<int> DequantizeLinearObj::getOpAttrVector() const
+    {
+        return {type.underlying(), axis};
+    }
+
+    QLinearMatMulObj::QLinearMatMulObj(GraphObj *graph, Tensor A, Tensor aScale,
+                                       Tensor aZeroPoint, Tensor B,
+                                       Tensor bScale, Tensor bZeroPoint,
+                                       Tensor yScale, Tensor yZeroPoint,
+                                       Tensor Y)
+        : OperatorObj(OpType::QLinearMatMul,
+                      {A, aScale, aZeroPoint, B, bScale, bZeroPoint, yScale,
+                       yZeroPoint},
+                      {Y})
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> QLinearMatMulObj::inferShape(const TensorVec &inputs)
+    {
+        const auto &A = inputs[0], &B = inputs[3];
+        if (A->getRank() < 2 || B->getRank() != 2)
+            return std::nullopt;
+        if (!isInt8Type(A->getDType()) || !isInt8Type(B->getDType()) ||
+            !isInt8Type(inputs[7]->getDType()))
+            return std::nullopt;
+        if (A->getDType() != inputs[2]->getDType() ||
+            B->getDType() != inputs[5]->getDType())
+            return std::nullopt;
+        for (int i : {1, 6})
+            if (inputs[i]->getDType() != DataType::Float32 ||
+                inputs[i]->size() != 1 || inputs[i + 1]->size() != 1)
+                return std::nullopt;
+
+        auto dims = A->getDims();
+        const auto &bDims = B->getDims();
+        if (dims.back() != bDims[0])
+            return std::nullopt;
+        k = bDims[0];
+        n = bDims[1];
+        m = A->size() / k;
+        // B is quantized per tensor or per output column
+        const auto &bScale = inputs[4], &bZeroPoint = inputs[5];
+        if (bScale->getDType() != DataType::Float32 ||
+            bScale->size() != bZeroPoint->size() ||
+            (bScale->size() != 1 && (int)bScale->size() != n))
+            return std::nullopt;
+
+        dims.back() = n;
+        return {{dims}};
+    }
+
+    vector<DataType> QLinearMatMulObj::inferDataType(const TensorVec &inputs) const
+    {
+        return {inputs[7]->getDType()};
+    }
+
+    optional<vector<bool>> QLinearMatMulObj::getTileSplit() const
+    {
+        return vector<bool>{true, false, false, false, false, false, false, false};
+    }
+
+    std::string QLinearMatMulObj::toString() const
+    {
+        std::ostringstream os;
+        os << "QLinearMatMul[" << getGuid() << "]";
+        os << "(A=" << inputs[0]->getGuid() << ",B=" << inputs[3]->getGuid()
+           << ",Y=" << outputs[0]->getGuid() << ",mnk=[" << m << "," << n << ","
+           << k << "])";
+        return os.str();
+    }
+
+}; // namespace infini
@@ -4,20 +4,11 @@ namespace infini
 {
     TransposeObj::TransposeObj(GraphObj *graph, Tensor input, Tensor output,
                                vector<int> permute)
-        : OperatorObj(OpType::Transpose, {input}, {output})
+        : OperatorObj(OpType::Transpose, {input}, {output}),
+          transposePermute(std::move(permute))
     {
-        auto rank = input->getRank();
-        if (permute.empty())
-        {
-            transposePermute.resize(rank);
-            for (size_t i = 0; i < rank; ++i)
-                transposePermute[i] = static_cast<int>(rank - 1 - i);
-        }
-        else
-        {
-            IT_ASSERT(rank == permute.size());
-            transposePermute = std::move(permute);
-        }
+        // An empty permutation is resolved by inferShape, since the rank of
+        // the input is not known yet while bulk building
         IT_ASSERT(checkValid(graph));
     }
 
@@ -31,6 +22,9 @@ namespace infini
         // =================================== 作业 ===================================
 
         const int rank = static_cast<int>(A->getRank());
+        if (transposePermute.empty())
+            for (int i = rank - 1; i >= 0; --i)
+                transposePermute.emplace_back(i);
         IT_ASSERT(static_cast<int>(transposePermute.size()) == rank);
 
         std::vector<int> seen(rank, 0);
@@ -49,6 +43,23 @@ namespace infini
         return {{output_dim}};
     }
 
+    optional<vector<SymShape>>
+    TransposeObj::inferSymShape(const vector<SymShape> &inputs) const
+    {
+        const auto &input_dim = inputs[0];
+        SymShape output_dim(input_dim.size());
+        for (size_t i = 0; i < input_dim.size(); ++i)
+            output_dim[i] = input_dim[transposePermute[i]];
+        return {{output_dim}};
+    }
+
+    optional<vector<bool>> TransposeObj::getTileSplit() const
+    {
+        if (transposePermute[0] != 0)
+            return std::nullopt;
+        return vector<bool>{true};
+    }
+
     std::string TransposeObj::toString() const
     {
         std::ostringstream os;
@@ -59,4 +70,11 @@ namespace infini
         os << "output=" << outputs[0]->getGuid() << ")";
         return os.str();
     }
+
+    vector<int> TransposeObj::getOpAttrVector() const
+    {
+        vector<int> ret = transposePermute;
+        ret.insert(ret.begin(), type.underlying());
+        return ret;
+    }
 }; // namespace infini
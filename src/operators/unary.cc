@@ -14,6 +14,17 @@ namespace infini
         return {{A->getDims()}};
     }
 
+    optional<vector<SymShape>>
+    UnaryObj::inferSymShape(const vector<SymShape> &inputs) const
+    {
+        return {{inputs[0]}};
+    }
+
+    optional<vector<bool>> UnaryObj::getTileSplit() const
+    {
+        return vector<bool>{true};
+    }
+
     std::string UnaryObj::toString() const
     {
         std::ostringstream os;
@@ -43,6 +54,17 @@ namespace infini
         return {{A->getDims()}};
     }
 
+    optional<vector<SymShape>>
+    ClipObj::inferSymShape(const vector<SymShape> &inputs) const
+    {
+        return {{inputs[0]}};
+    }
+
+    optional<vector<bool>> ClipObj::getTileSplit() const
+    {
+        return vector<bool>{true};
+    }
+
     std::string ClipObj::toString() const
     {
         std::ostringstream os;
@@ -54,6 +76,20 @@ namespace infini
         return os.str();
     }
 
+    vector<int> ClipObj::getOpAttrVector() const
+    {
+        // Bounds are compared bit for bit
+        auto bits = [](std::optional<float> v)
+        {
+            int32_t b = 0;
+            if (v)
+                std::memcpy(&b, &*v, sizeof(b));
+            return b;
+        };
+        return {type.underlying(), minValue.has_value(), bits(minValue),
+                maxValue.has_value(), bits(maxValue)};
+    }
+
     CastObj::CastObj(GraphObj *graph, Tensor input, Tensor output, CastType type)
         : OperatorObj(OpType::Cast, {input}, {output}), castType(type)
     {
@@ -73,6 +109,17 @@ namespace infini
         return {{A->getDims()}};
     }
 
+    optional<vector<SymShape>>
+    CastObj::inferSymShape(const vector<SymShape> &inputs) const
+    {
+        return {{inputs[0]}};
+    }
+
+    optional<vector<bool>> CastObj::getTileSplit() const
+    {
+        return vector<bool>{true};
+    }
+
     std::string CastObj::toString() const
     {
         std::ostringstream os;
@@ -82,6 +129,11 @@ namespace infini
         return os.str();
     }
 
+    vector<int> CastObj::getOpAttrVector() const
+    {
+        return {type.underlying(), static_cast<int>(castType)};
+    }
+
     DataType CastObj::getOutputDataType() const
     {
         switch (castType)
@@ -0,0 +1,676 @@
+// Python bindings written against the CPython C API, so that building them
+// only needs the Python development headers CMake already looks for.
+//
+//   import pyinfinitensor as it
+//   g = it.Graph()
+//   x = g.tensor([2, 3])
+//   y = g.relu(x)
+//   g.data_malloc()
+//   numpy.asarray(x)[:] = ...   # tensors export the buffer protocol
+//   g.run()
+//
+// data_malloc() and optimize() raise BufferError while a view of a tensor is
+// alive, as they may free the memory it points to.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+#include <memory>
+
+namespace infini
+{
+    namespace
+    {
+        struct PyGraph
+        {
+            PyObject_HEAD Graph graph;
+            // Buffers bound with Graph.bind, held until rebound
+            std::unordered_map<TensorObj *, std::unique_ptr<Py_buffer>> *bound;
+            // Buffers of its tensors exported and not yet released. They
+            // point into the arena, which must not be replanned meanwhile.
+            Py_ssize_t exports;
+        };
+
+        struct PyTensor
+        {
+            PyObject_HEAD Tensor tensor;
+            // Keeps the graph, which owns the tensor memory, alive
+            PyObject *graph;
+        };
+
+        PyTypeObject PyGraphType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+        PyTypeObject PyTensorType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+        struct DTypeInfo
+        {
+            const char *name;
+            DataType dtype;
+            // struct module format of an element; BFloat16 has none and is
+            // exported as its uint16 storage
+            const char *format;
+        };
+
+        const DTypeInfo dtypes[] = {
+            {"float32", DataType::Float32, "f"}, {"float16", DataType::Float16, "e"},
+            {"bfloat16", DataType::BFloat16, "H"}, {"float64", DataType::Double, "d"},
+            {"int8", DataType::Int8, "b"}, {"uint8", DataType::UInt8, "B"},
+            {"int16", DataType::Int16, "h"}, {"uint16", DataType::UInt16, "H"},
+            {"int32", DataType::Int32, "i"}, {"uint32", DataType::UInt32, "I"},
+            {"int64", DataType::Int64, "q"}, {"uint64", DataType::UInt64, "Q"},
+            {"bool", DataType::Bool, "?"},
+        };
+
+        const DTypeInfo *findDType(DataType dtype)
+        {
+            for (auto &info : dtypes)
+                if (info.dtype == dtype)
+                    return &info;
+            return nullptr;
+        }
+
+        const DTypeInfo *findDType(const char *name)
+        {
+            for (auto &info : dtypes)
+                if (std::strcmp(info.name, name) == 0)
+                    return &info;
+            return nullptr;
+        }
+
+// C++ exceptions, IT_ASSERT failures included, must not cross into Python
+#define PY_TRY \
+    try        \
+    {
+#define PY_CATCH                                          \
+    }                                                     \
+    catch (const std::exception &e)                       \
+    {                                                     \
+        PyErr_SetString(PyExc_RuntimeError, e.what());    \
+        return nullptr;                                   \
+    }
+
+        PyObject *wrapTensor(PyObject *graph, const Tensor &tensor)
+        {
+            auto *self = PyObject_New(PyTensor, &PyTensorType);
+            if (!self)
+                return nullptr;
+            new (&self->tensor) Tensor(tensor);
+            Py_INCREF(graph);
+            self->graph = graph;
+            return reinterpret_cast<PyObject *>(self);
+        }
+
+        PyObject *wrapTensors(PyObject *graph, const TensorVec &tensors)
+        {
+            PyObject *list = PyList_New(tensors.size());
+            if (!list)
+                return nullptr;
+            for (size_t i = 0; i < tensors.size(); ++i)
+            {
+                PyObject *item = wrapTensor(graph, tensors[i]);
+                if (!item)
+                {
+                    Py_DECREF(list);
+                    return nullptr;
+                }
+                PyList_SET_ITEM(list, i, item);
+            }
+            return list;
+        }
+
+        // Returns nullptr with a Python error set if obj is not a Tensor
+        Tensor unwrapTensor(PyObject *obj)
+        {
+            if (!PyObject_TypeCheck(obj, &PyTensorType))
+            {
+                PyErr_SetString(PyExc_TypeError, "expected a Tensor");
+                return nullptr;
+            }
+            return reinterpret_cast<PyTensor *>(obj)->tensor;
+        }
+
+        // Fills a Shape or a vector<int>
+        template <typename Ints>
+        bool parseInts(PyObject *seq, Ints &out)
+        {
+            PyObject *fast = PySequence_Fast(seq, "expected a sequence of ints");
+            if (!fast)
+                return false;
+            const Py_ssize_t n = PySequence_Fast_GET_SIZE(fast);
+            for (Py_ssize_t i = 0; i < n; ++i)
+            {
+                long v = PyLong_AsLong(PySequence_Fast_GET_ITEM(fast, i));
+                if (v == -1 && PyErr_Occurred())
+                {
+                    Py_DECREF(fast);
+                    return false;
+                }
+                out.emplace_back(static_cast<int>(v));
+            }
+            Py_DECREF(fast);
+            return true;
+        }
+
+        PyObject *toShape(const Shape &shape)
+        {
+            PyObject *tuple = PyTuple_New(shape.size());
+            if (!tuple)
+                return nullptr;
+            for (size_t i = 0; i < shape.size(); ++i)
+                PyTuple_SET_ITEM(tuple, i, PyLong_FromLong(shape[i]));
+            return tuple;
+        }
+
+        // ---------------------------------------------------------------
+        // Tensor
+
+        void tensorDealloc(PyTensor *self)
+        {
+            self->tensor.~Tensor();
+            Py_XDECREF(self->graph);
+            Py_TYPE(self)->tp_free(reinterpret_cast<PyObject *>(self));
+        }
+
+        PyObject *tensorShape(PyTensor *self, void *)
+        {
+            return toShape(self->tensor->getDims());
+        }
+
+        PyObject *tensorDType(PyTensor *self, void *)
+        {
+            auto *info = findDType(self->tensor->getDType());
+            return PyUnicode_FromString(
+                info ? info->name : self->tensor->getDType().toString().c_str());
+        }
+
+        PyObject *tensorRepr(PyTensor *self)
+        {
+            PY_TRY
+            return PyUnicode_FromString(self->tensor->toString().c_str());
+            PY_CATCH
+        }
+
+        // Exports the tensor memory as a C-contiguous buffer, so that
+        // numpy.asarray(tensor) is a view without a copy.
+        int tensorGetBuffer(PyTensor *self, Py_buffer *view, int flags)
+        {
+            const auto &tensor = self->tensor;
+            auto *info = findDType(tensor->getDType());
+            if (!info)
+            {
+                PyErr_SetString(PyExc_BufferError, "unsupported data type");
+                return -1;
+            }
+            void *ptr;
+            try
+            {
+                ptr = tensor->getRawDataPtr<void *>();
+            }
+            catch (const std::exception &)
+            {
+                PyErr_SetString(PyExc_BufferError,
+                                "tensor has no memory, call data_malloc first");
+                return -1;
+            }
+
+            const auto dims = tensor->getDims();
+            const Py_ssize_t itemsize = tensor->getDType().getSize();
+            auto *layout = new Py_ssize_t[2 * dims.size() + 1];
+            Py_ssize_t stride = itemsize;
+            for (size_t i = dims.size(); i-- > 0;)
+            {
+                layout[i] = dims[i];
+                layout[dims.size() + i] = stride;
+                stride *= dims[i];
+            }
+
+            view->buf = ptr;
+            view->obj = reinterpret_cast<PyObject *>(self);
+            Py_INCREF(view->obj);
+            view->len = tensor->getBytes();
+            view->readonly = 0;
+            view->itemsize = itemsize;
+            view->format = (flags & PyBUF_FORMAT)
+                               ? const_cast<char *>(info->format)
+                               : nullptr;
+            view->ndim = static_cast<int>(dims.size());
+            view->shape = (flags & PyBUF_ND) ? layout : nullptr;
+            view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES
+                                ? layout + dims.size()
+                                : nullptr;
+            view->suboffsets = nullptr;
+            view->internal = layout;
+            ++reinterpret_cast<PyGraph *>(self->graph)->exports;
+            return 0;
+        }
+
+        void tensorReleaseBuffer(PyTensor *self, Py_buffer *view)
+        {
+            delete[] static_cast<Py_ssize_t *>(view->internal);
+            --reinterpret_cast<PyGraph *>(self->graph)->exports;
+        }
+
+        PyGetSetDef tensorGetSet[] = {
+            {"shape", reinterpret_cast<getter>(tensorShape), nullptr,
+             "Dims of the tensor", nullptr},
+            {"dtype", reinterpret_cast<getter>(tensorDType), nullptr,
+             "Data type name, e.g. float32", nullptr},
+            {nullptr, nullptr, nullptr, nullptr, nullptr},
+        };
+
+        PyBufferProcs tensorBuffer = {
+            reinterpret_cast<getbufferproc>(tensorGetBuffer),
+            reinterpret_cast<releasebufferproc>(tensorReleaseBuffer),
+        };
+
+        // ---------------------------------------------------------------
+        // Graph
+
+        PyObject *graphNew(PyTypeObject *type, PyObject *, PyObject *)
+        {
+            auto *self = reinterpret_cast<PyGraph *>(type->tp_alloc(type, 0));
+            if (!self)
+                return nullptr;
+            new (&self->graph) Graph(
+                make_ref<GraphObj>(NativeCpuRuntimeObj::getInstance()));
+            self->bound =
+                new std::unordered_map<TensorObj *, std::unique_ptr<Py_buffer>>();
+            self->exports = 0;
+            return reinterpret_cast<PyObject *>(self);
+        }
+
+        void graphDealloc(PyGraph *self)
+        {
+            if (self->bound)
+            {
+                for (auto &[t, view] : *self->bound)
+                    PyBuffer_Release(view.get());
+                delete self->bound;
+            }
+            self->graph.~Graph();
+            Py_TYPE(self)->tp_free(reinterpret_cast<PyObject *>(self));
+        }
+
+        PyObject *graphTensor(PyGraph *self, PyObject *args, PyObject *kwargs)
+        {
+            static const char *keywords[] = {"shape", "dtype", nullptr};
+            PyObject *shapeObj;
+            const char *dtypeName = "float32";
+            if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|s",
+                                             const_cast<char **>(keywords),
+                                             &shapeObj, &dtypeName))
+                return nullptr;
+            Shape shape;
+            if (!parseInts(shapeObj, shape))
+                return nullptr;
+            auto *info = findDType(dtypeName);
+            if (!info)
+                return PyErr_Format(PyExc_ValueError, "unknown dtype %s",
+                                    dtypeName);
+            PY_TRY
+            return wrapTensor(reinterpret_cast<PyObject *>(self),
+                              self->graph->addTensor(shape, info->dtype));
+            PY_CATCH
+        }
+
+        template <typename T>
+        PyObject *graphBinary(PyGraph *self, PyObject *args)
+        {
+            PyObject *a, *b;
+            if (!PyArg_ParseTuple(args, "OO", &a, &b))
+                return nullptr;
+            Tensor ta = unwrapTensor(a), tb = unwrapTensor(b);
+            if (!ta || !tb)
+                return nullptr;
+            PY_TRY
+            auto op = self->graph->addOp<T>(ta, tb, nullptr);
+            return wrapTensor(reinterpret_cast<PyObject *>(self), op->getOutput());
+            PY_CATCH
+        }
+
+        PyObject *graphMatmul(PyGraph *self, PyObject *args, PyObject *kwargs)
+        {
+            static const char *keywords[] = {"a", "b", "trans_a", "trans_b",
+                                             nullptr};
+            PyObject *a, *b;
+            int transA = 0, transB = 0;
+            if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|pp",
+                                             const_cast<char **>(keywords), &a,
+                                             &b, &transA, &transB))
+                return nullptr;
+            Tensor ta = unwrapTensor(a), tb = unwrapTensor(b);
+            if (!ta || !tb)
+                return nullptr;
+            PY_TRY
+            auto op = self->graph->addOp<MatmulObj>(ta, tb, nullptr, transA != 0,
+                                                    transB != 0);
+            return wrapTensor(reinterpret_cast<PyObject *>(self), op->getOutput());
+            PY_CATCH
+        }
+
+        template <typename T>
+        PyObject *graphUnary(PyGraph *self, PyObject *arg)
+        {
+            Tensor input = unwrapTensor(arg);
+            if (!input)
+                return nullptr;
+            PY_TRY
+            auto op = self->graph->addOp<T>(input, nullptr);
+            return wrapTensor(reinterpret_cast<PyObject *>(self), op->getOutput());
+            PY_CATCH
+        }
+
+        PyObject *graphClip(PyGraph *self, PyObject *args, PyObject *kwargs)
+        {
+            static const char *keywords[] = {"x", "min", "max", nullptr};
+            PyObject *x, *minObj = Py_None, *maxObj = Py_None;
+            if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OO",
+                                             const_cast<char **>(keywords), &x,
+                                             &minObj, &maxObj))
+                return nullptr;
+            Tensor input = unwrapTensor(x);
+            if (!input)
+                return nullptr;
+            std::optional<float> minValue, maxValue;
+            if (minObj != Py_None)
+                minValue = static_cast<float>(PyFloat_AsDouble(minObj));
+            if (maxObj != Py_None)
+                maxValue = static_cast<float>(PyFloat_AsDouble(maxObj));
+            if (PyErr_Occurred())
+                return nullptr;
+            PY_TRY
+            auto op = self->graph->addOp<ClipObj>(input, nullptr, minValue,
+                                                  maxValue);
+            return wrapTensor(reinterpret_cast<PyObject *>(self), op->getOutput());
+            PY_CATCH
+        }
+
+        PyObject *graphTranspose(PyGraph *self, PyObject *args, PyObject *kwargs)
+        {
+            static const char *keywords[] = {"x", "perm", nullptr};
+            PyObject *x, *permObj = Py_None;
+            if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O",
+                                             const_cast<char **>(keywords), &x,
+                                             &permObj))
+                return nullptr;
+            Tensor input = unwrapTensor(x);
+            if (!input)
+                return nullptr;
+            vector<int> perm;
+            if (permObj != Py_None && !parseInts(permObj, perm))
+                return nullptr;
+            PY_TRY
+            auto op = self->graph->addOp<TransposeObj>(input, nullptr, perm);
+            return wrapTensor(reinterpret_cast<PyObject *>(self), op->getOutput());
+            PY_CATCH
+        }
+
+        bool parseTensors(PyObject *seq, TensorVec &out)
+        {
+            PyObject *fast = PySequence_Fast(seq, "expected a sequence of Tensors");
+            if (!fast)
+                return false;
+            for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(fast); ++i)
+            {
+                Tensor t = unwrapTensor(PySequence_Fast_GET_ITEM(fast, i));
+                if (!t)
+                {
+                    Py_DECREF(fast);
+                    return false;
+                }
+                out.emplace_back(t);
+            }
+            Py_DECREF(fast);
+            return true;
+        }
+
+        PyObject *graphConcat(PyGraph *self, PyObject *args)
+        {
+            PyObject *seq;
+            int axis;
+            if (!PyArg_ParseTuple(args, "Oi", &seq, &axis))
+                return nullptr;
+            TensorVec inputs;
+            if (!parseTensors(seq, inputs))
+                return nullptr;
+            PY_TRY
+            auto op = self->graph->addOp<ConcatObj>(inputs, nullptr, axis);
+            return wrapTensor(reinterpret_cast<PyObject *>(self), op->getOutput());
+            PY_CATCH
+        }
+
+        // Replanning frees the arena under the exported buffers, so it is
+        // refused while any of them is alive.
+        bool checkNoExports(PyGraph *self)
+        {
+            if (self->exports == 0)
+                return true;
+            PyErr_Format(PyExc_BufferError,
+                         "%zd tensor buffers are still exported, release the "
+                         "views before replanning",
+                         self->exports);
+            return false;
+        }
+
+        PyObject *graphOptimize(PyGraph *self, PyObject *)
+        {
+            if (!checkNoExports(self))
+                return nullptr;
+            PY_TRY
+            self->graph->optimize();
+            Py_RETURN_NONE;
+            PY_CATCH
+        }
+
+        PyObject *graphDataMalloc(PyGraph *self, PyObject *)
+        {
+            if (!checkNoExports(self))
+                return nullptr;
+            PY_TRY
+            self->graph->dataMalloc();
+            Py_RETURN_NONE;
+            PY_CATCH
+        }
+
+        PyObject *graphRun(PyGraph *self, PyObject *)
+        {
+            // Kernels do not touch Python objects, let other threads run. The
+            // error is raised once the thread state is restored.
+            string error;
+            Py_BEGIN_ALLOW_THREADS
+            try
+            {
+                self->graph->getRuntime()->run(self->graph);
+            }
+            catch (const std::exception &e)
+            {
+                error = e.what();
+            }
+            Py_END_ALLOW_THREADS
+            if (!error.empty())
+            {
+                PyErr_SetString(PyExc_RuntimeError, error.c_str());
+                return nullptr;
+            }
+            Py_RETURN_NONE;
+        }
+
+        // Binds the memory of a writable, C-contiguous buffer (e.g. a NumPy
+        // array) to a graph input or output, see GraphObj::bindData. The
+        // buffer is held until the tensor is rebound or the graph is freed.
+        PyObject *graphBind(PyGraph *self, PyObject *args)
+        {
+            PyObject *tensorObj, *bufferObj;
+            if (!PyArg_ParseTuple(args, "OO", &tensorObj, &bufferObj))
+                return nullptr;
+            Tensor tensor = unwrapTensor(tensorObj);
+            if (!tensor)
+                return nullptr;
+            auto view = std::make_unique<Py_buffer>();
+            if (PyObject_GetBuffer(bufferObj, view.get(),
+                                   PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE |
+                                       PyBUF_FORMAT) != 0)
+                return nullptr;
+            if (static_cast<size_t>(view->len) != tensor->getBytes() ||
+                static_cast<size_t>(view->itemsize) !=
+                    tensor->getDType().getSize())
+            {
+                const Py_ssize_t len = view->len;
+                PyBuffer_Release(view.get());
+                return PyErr_Format(PyExc_ValueError,
+                                    "buffer of %zd bytes does not match the "
+                                    "tensor",
+                                    len);
+            }
+            try
+            {
+                self->graph->bindData(tensor, view->buf);
+            }
+            catch (const std::exception &e)
+            {
+                PyBuffer_Release(view.get());
+                PyErr_SetString(PyExc_RuntimeError, e.what());
+                return nullptr;
+            }
+            auto &slot = (*self->bound)[tensor.get()];
+            if (slot)
+                PyBuffer_Release(slot.get());
+            slot = std::move(view);
+            Py_RETURN_NONE;
+        }
+
+        PyObject *graphInputs(PyGraph *self, PyObject *)
+        {
+            PY_TRY
+            return wrapTensors(reinterpret_cast<PyObject *>(self),
+                               self->graph->getInputs());
+            PY_CATCH
+        }
+
+        PyObject *graphOutputs(PyGraph *self, PyObject *)
+        {
+            PY_TRY
+            return wrapTensors(reinterpret_cast<PyObject *>(self),
+                               self->graph->getOutputs());
+            PY_CATCH
+        }
+
+        PyObject *graphSetOutputs(PyGraph *self, PyObject *seq)
+        {
+            TensorVec outputs;
+            if (!parseTensors(seq, outputs))
+                return nullptr;
+            PY_TRY
+            self->graph->setOutputs(outputs);
+            Py_RETURN_NONE;
+            PY_CATCH
+        }
+
+        PyObject *graphRepr(PyGraph *self)
+        {
+            PY_TRY
+            return PyUnicode_FromString(self->graph->toString().c_str());
+            PY_CATCH
+        }
+
+        PyMethodDef graphMethods[] = {
+            {"tensor", reinterpret_cast<PyCFunction>(graphTensor),
+             METH_VARARGS | METH_KEYWORDS, "tensor(shape, dtype='float32')"},
+            {"add", reinterpret_cast<PyCFunction>(graphBinary<AddObj>),
+             METH_VARARGS, "add(a, b)"},
+            {"sub", reinterpret_cast<PyCFunction>(graphBinary<SubObj>),
+             METH_VARARGS, "sub(a, b)"},
+            {"mul", reinterpret_cast<PyCFunction>(graphBinary<MulObj>),
+             METH_VARARGS, "mul(a, b)"},
+            {"div", reinterpret_cast<PyCFunction>(graphBinary<DivObj>),
+             METH_VARARGS, "div(a, b)"},
+            {"matmul", reinterpret_cast<PyCFunction>(graphMatmul),
+             METH_VARARGS | METH_KEYWORDS,
+             "matmul(a, b, trans_a=False, trans_b=False)"},
+            {"relu", reinterpret_cast<PyCFunction>(graphUnary<ReluObj>), METH_O,
+             "relu(x)"},
+            {"gelu", reinterpret_cast<PyCFunction>(graphUnary<GeluObj>), METH_O,
+             "gelu(x)"},
+            {"silu", reinterpret_cast<PyCFunction>(graphUnary<SiluObj>), METH_O,
+             "silu(x)"},
+            {"sigmoid", reinterpret_cast<PyCFunction>(graphUnary<SigmoidObj>),
+             METH_O, "sigmoid(x)"},
+            {"tanh", reinterpret_cast<PyCFunction>(graphUnary<TanhObj>), METH_O,
+             "tanh(x)"},
+            {"exp", reinterpret_cast<PyCFunction>(graphUnary<ExpObj>), METH_O,
+             "exp(x)"},
+            {"clip", reinterpret_cast<PyCFunction>(graphClip),
+             METH_VARARGS | METH_KEYWORDS, "clip(x, min=None, max=None)"},
+            {"transpose", reinterpret_cast<PyCFunction>(graphTranspose),
+             METH_VARARGS | METH_KEYWORDS, "transpose(x, perm=None)"},
+            {"concat", reinterpret_cast<PyCFunction>(graphConcat), METH_VARARGS,
+             "concat(tensors, axis)"},
+            {"optimize", reinterpret_cast<PyCFunction>(graphOptimize),
+             METH_NOARGS, "Run the graph optimization passes"},
+            {"data_malloc", reinterpret_cast<PyCFunction>(graphDataMalloc),
+             METH_NOARGS, "Plan and allocate the tensor memory"},
+            {"run", reinterpret_cast<PyCFunction>(graphRun), METH_NOARGS,
+             "Run the graph"},
+            {"bind", reinterpret_cast<PyCFunction>(graphBind), METH_VARARGS,
+             "bind(tensor, buffer): use a writable buffer as tensor memory"},
+            {"inputs", reinterpret_cast<PyCFunction>(graphInputs), METH_NOARGS,
+             "Graph input tensors"},
+            {"outputs", reinterpret_cast<PyCFunction>(graphOutputs),
+             METH_NOARGS, "Graph output tensors"},
+            {"set_outputs", reinterpret_cast<PyCFunction>(graphSetOutputs),
+             METH_O, "set_outputs(tensors): mark the tensors the graph is run for"},
+            {nullptr, nullptr, 0, nullptr},
+        };
+
+        PyModuleDef moduleDef = {
+            PyModuleDef_HEAD_INIT, "pyinfinitensor",
+            "Python bindings of InfiniTensor", -1, nullptr,
+        };
+    } // namespace
+} // namespace infini
+
+PyMODINIT_FUNC PyInit_pyinfinitensor()
+{
+    using namespace infini;
+
+    PyTensorType.tp_name = "pyinfinitensor.Tensor";
+    PyTensorType.tp_basicsize = sizeof(PyTensor);
+    PyTensorType.tp_dealloc = reinterpret_cast<destructor>(tensorDealloc);
+    PyTensorType.tp_repr = reinterpret_cast<reprfunc>(tensorRepr);
+    PyTensorType.tp_as_buffer = &tensorBuffer;
+    PyTensorType.tp_flags = Py_TPFLAGS_DEFAULT;
+    PyTensorType.tp_doc = "A tensor of a Graph, created by Graph methods";
+    PyTensorType.tp_getset = tensorGetSet;
+
+    PyGraphType.tp_name = "pyinfinitensor.Graph";
+    PyGraphType.tp_basicsize = sizeof(PyGraph);
+    PyGraphType.tp_dealloc = reinterpret_cast<destructor>(graphDealloc);
+    PyGraphType.tp_repr = reinterpret_cast<reprfunc>(graphRepr);
+    PyGraphType.tp_flags = Py_TPFLAGS_DEFAULT;
+    PyGraphType.tp_doc = "A computation graph on the CPU runtime";
+    PyGraphType.tp_methods = graphMethods;
+    PyGraphType.tp_new = graphNew;
+
+    if (PyType_Ready(&PyTensorType) < 0 || PyType_Ready(&PyGraphType) < 0)
+        return nullptr;
+
+    PyObject *module = PyModule_Create(&moduleDef);
+    if (!module)
+        return nullptr;
+    Py_INCREF(&PyGraphType);
+    Py_INCREF(&PyTensorType);
+    if (PyModule_AddObject(module, "Graph",
+                           reinterpret_cast<PyObject *>(&PyGraphType)) < 0 ||
+        PyModule_AddObject(module, "Tensor",
+                           reinterpret_cast<PyObject *>(&PyTensorType)) < 0)
+    {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
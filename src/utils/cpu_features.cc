@@ -0,0 +1,24 @@
+#include "utils/cpu_features.h"
+
+namespace infini {
+
+static CpuFeatures detectCpuFeatures() {
+    CpuFeatures features;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.fma = __builtin_cpu_supports("fma");
+    features.f16c = __builtin_cpu_supports("f16c");
+    features.avxvnni = __builtin_cpu_supports("avxvnni");
+    features.avx512vnni = __builtin_cpu_supports("avx512vnni") &&
+                          __builtin_cpu_supports("avx512vl");
+#endif
+    return features;
+}
+
+const CpuFeatures &CpuFeatures::get() {
+    static const CpuFeatures features = detectCpuFeatures();
+    return features;
+}
+
+} // namespace infini
@@ -33,6 +33,31 @@ namespace infini
         return out;
     }
 
+    optional<SymShape> infer_broadcast(const SymShape &A, const SymShape &B)
+    {
+        const size_t rankA = A.size();
+        const size_t rankB = B.size();
+        const size_t rank = std::max(rankA, rankB);
+        SymShape out(rank, 1);
+
+        for (size_t i = 0; i < rank; ++i)
+        {
+            const DimExpr dimA = (i < rank - rankA) ? 1 : A[i - (rank - rankA)];
+            const DimExpr dimB = (i < rank - rankB) ? 1 : B[i - (rank - rankB)];
+            if (dimA == dimB)
+                out[i] = dimA;
+            else if (dimA == 1)
+                out[i] = dimB;
+            else if (dimB == 1)
+                out[i] = dimA;
+            else if (dimA.isConstant() && dimB.isConstant())
+                IT_ASSERT(false, "Broadcast shape mismatch");
+            else
+                return std::nullopt;
+        }
+        return out;
+    }
+
     int get_real_axis(const int &axis, const int &rank)
     {
         IT_ASSERT(rank >= 1);
@@ -94,7 +119,8 @@ namespace infini
     {
         std::string deviceStr = device_to_str(std::get<0>(kernelAttrs));
         std::string opStr = OpType(std::get<1>(kernelAttrs)).toString();
-        return deviceStr + ", " + opStr;
+        return deviceStr + ", " + opStr + ", " +
+               std::get<2>(kernelAttrs).toString();
     }
 
 } // namespace infini
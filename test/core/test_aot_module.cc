@@ -0,0 +1,66 @@
+#include "core/aot_module.h"
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(AotModule, MatchesInterpreter)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({2, 3, 4}, DataType::Float32);
+        auto b = g->addTensor({5, 4}, DataType::Float32);
+        auto bias = g->addTensor({5}, DataType::Float32);
+        auto mm = g->addOp<MatmulObj>(a, b, nullptr, false, true)->getOutput();
+        auto add = g->addOp<AddObj>(mm, bias, nullptr)->getOutput();
+        auto relu = g->addOp<ReluObj>(add, nullptr)->getOutput();
+        auto clip =
+            g->addOp<ClipObj>(relu, nullptr, std::nullopt, 20.f)->getOutput();
+        auto trans = g->addOp<TransposeObj>(clip, nullptr, vector<int>{0, 2, 1})
+                         ->getOutput();
+        auto toInt =
+            g->addOp<CastObj>(trans, nullptr, CastType::Float2Int32)->getOutput();
+        auto back =
+            g->addOp<CastObj>(toInt, nullptr, CastType::Int322Float)->getOutput();
+        auto y = g->addOp<ConcatObj>(TensorVec{trans, back}, nullptr, 2)
+                     ->getOutput();
+
+        vector<float> aData(a->size()), bData(b->size()), biasData(bias->size());
+        g->bindData(a, aData.data());
+        g->bindData(b, bData.data());
+        g->bindData(bias, biasData.data());
+        g->dataMalloc();
+
+        auto source = AotModuleObj::generate(g);
+        // Only the saturating cast goes through its kernel
+        EXPECT_NE(source.find("Cast (kernel)"), string::npos);
+        EXPECT_EQ(source.find("MatMul (kernel)"), string::npos);
+        EXPECT_EQ(source.find("Concat (kernel)"), string::npos);
+
+        auto module = AotModuleObj::compile(g);
+        for (int request = 0; request < 2; ++request)
+        {
+            for (size_t i = 0; i < aData.size(); ++i)
+                aData[i] = float(int(i % 7) - 3) * (request + 1) * 0.5f;
+            for (size_t i = 0; i < bData.size(); ++i)
+                bData[i] = float(int(i % 5) - 1);
+            for (size_t i = 0; i < biasData.size(); ++i)
+                biasData[i] = float(i) - 2.f;
+
+            runtime->run(g);
+            auto ptr = y->getRawDataPtr<float *>();
+            vector<float> expected(ptr, ptr + y->size());
+            std::fill(ptr, ptr + y->size(), -1.f);
+            module->run();
+            EXPECT_TRUE(y->equalData(expected));
+        }
+    }
+} // namespace infini
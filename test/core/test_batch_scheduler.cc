@@ -0,0 +1,83 @@
+#include "core/batch_scheduler.h"
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    // Relu(x * w) with x (rows, 8) and w (8, 4) = 1
+    static std::pair<Graph, Tensor> buildGraph()
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({1, 8}, DataType::Float32);
+        auto w = g->addTensor({8, 4}, DataType::Float32);
+        auto mm = g->addOp<MatmulObj>(x, w, nullptr);
+        g->addOp<ReluObj>(mm->getOutput(), nullptr);
+        g->dataMalloc();
+        w->setData(OneGenerator());
+        return {g, x};
+    }
+
+    static BatchScheduler::Buffer toBuffer(const vector<float> &data)
+    {
+        auto *ptr = reinterpret_cast<const uint8_t *>(data.data());
+        return BatchScheduler::Buffer(ptr, ptr + data.size() * sizeof(float));
+    }
+
+    static vector<float> toFloats(const BatchScheduler::Buffer &buffer)
+    {
+        vector<float> data(buffer.size() / sizeof(float));
+        std::memcpy(data.data(), buffer.data(), buffer.size());
+        return data;
+    }
+
+    TEST(BatchScheduler, CoalescesRequests)
+    {
+        auto [g, x] = buildGraph();
+        BatchScheduler scheduler(g, {x}, 4, std::chrono::seconds(10));
+
+        // Two rows per request: row sums are 8 * i and -8 * i
+        vector<std::future<vector<BatchScheduler::Buffer>>> futures;
+        for (int i = 0; i < 8; ++i)
+        {
+            vector<float> rows(16, float(i));
+            std::fill(rows.begin() + 8, rows.end(), float(-i));
+            futures.emplace_back(scheduler.submit({toBuffer(rows)}));
+        }
+        for (int i = 0; i < 8; ++i)
+        {
+            auto results = futures[i].get();
+            ASSERT_EQ(results.size(), 1);
+            vector<float> ans(8, 0.f);
+            std::fill(ans.begin(), ans.begin() + 4, 8.f * i);
+            EXPECT_EQ(toFloats(results[0]), ans);
+        }
+        // Full batches are run without waiting for the deadline
+        EXPECT_EQ(scheduler.getNumBatches(), 4);
+    }
+
+    TEST(BatchScheduler, RunsPartialBatchAtDeadline)
+    {
+        auto [g, x] = buildGraph();
+        BatchScheduler scheduler(g, {x}, 16, std::chrono::milliseconds(1));
+        auto a = scheduler.submit({toBuffer(vector<float>(8, 1.f))});
+        EXPECT_EQ(toFloats(a.get()[0]), vector<float>(4, 8.f));
+        void *single = g->getArenaBase();
+        auto b = scheduler.submit({toBuffer(vector<float>(24, 2.f))});
+        EXPECT_EQ(toFloats(b.get()[0]), vector<float>(12, 16.f));
+        EXPECT_EQ(scheduler.getNumBatches(), 2);
+        // 3 rows are padded to 4
+        EXPECT_EQ(x->getDims(), (Shape{4, 8}));
+
+        // Returning to a batch size reuses its plan
+        auto c = scheduler.submit({toBuffer(vector<float>(8, 3.f))});
+        EXPECT_EQ(toFloats(c.get()[0]), vector<float>(4, 24.f));
+        EXPECT_EQ(x->getDims(), (Shape{1, 8}));
+        EXPECT_EQ(g->getArenaBase(), single);
+    }
+} // namespace infini
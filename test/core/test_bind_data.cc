@@ -0,0 +1,63 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    // Relu -> Add with a bias; input and output live in caller buffers
+    static void runBound(size_t tileBytes)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({16, 8}, DataType::Float32);
+        auto bias = g->addTensor({8}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(x, nullptr);
+        auto y = g->addOp<AddObj>(relu->getOutput(), bias, nullptr)->getOutput();
+        g->setTileStreaming(tileBytes);
+
+        vector<float> in(x->size()), out(y->size());
+        g->bindData(x, in.data());
+        g->bindData(y, out.data());
+        g->dataMalloc();
+        bias->setData(OneGenerator());
+        // Only the bias and the Relu output are planned
+        EXPECT_LE(g->getArenaBytes(), (8 + 16 * 8) * sizeof(float));
+
+        for (int request = 0; request < 3; ++request)
+        {
+            // A new pair of buffers per request, used in place
+            vector<float> in2(x->size()), out2(y->size());
+            for (size_t i = 0; i < in2.size(); ++i)
+                in2[i] = float(int(i % 5) - 2) * (request + 1);
+            g->bindData(x, in2.data());
+            g->bindData(y, out2.data());
+            runtime->run(g);
+            for (size_t i = 0; i < out2.size(); ++i)
+                EXPECT_EQ(out2[i], std::max(in2[i], 0.f) + 1.f);
+        }
+        EXPECT_EQ(out, vector<float>(out.size(), 0.f));
+    }
+
+    TEST(BindData, ZeroCopyInputsAndOutputs) { runBound(0); }
+
+    TEST(BindData, TileStreamed) { runBound(256); }
+
+    TEST(BindData, RejectsInvalidBuffers)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({4}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(x, nullptr);
+        g->addOp<ReluObj>(relu->getOutput(), nullptr);
+        vector<float> buffer(8);
+        EXPECT_THROW(
+            g->bindData(x, reinterpret_cast<char *>(buffer.data()) + 2),
+            Exception);
+        // Intermediates stay in the arena
+        EXPECT_THROW(g->bindData(relu->getOutput(), buffer.data()), Exception);
+    }
+} // namespace infini
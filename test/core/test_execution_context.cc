@@ -0,0 +1,87 @@
+#include "core/execution_context.h"
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+
+#include "test.h"
+#include <thread>
+
+namespace infini
+{
+    // Relu -> Transpose -> Add on a (64, 4, 8) input and an (8, 4) bias,
+    // each worker feeding its own input and reading its own output while the
+    // bias stays shared in the graph.
+    static void runConcurrently(size_t tileBytes)
+    {
+        const int rows = 64, h = 4, w = 8, workers = 4;
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto input = g->addTensor({rows, h, w}, DataType::Float32);
+        auto bias = g->addTensor({w, h}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(input, nullptr);
+        auto trans =
+            g->addOp<TransposeObj>(relu->getOutput(), nullptr, Shape{0, 2, 1});
+        auto output = g->addOp<AddObj>(trans->getOutput(), bias, nullptr)
+                          ->getOutput();
+        g->setTileStreaming(tileBytes);
+        g->dataMalloc();
+        bias->setData(IncrementalGenerator());
+
+        vector<int> failures(workers, 0);
+        vector<std::thread> threads;
+        for (int id = 0; id < workers; ++id)
+            threads.emplace_back(
+                [&, id]
+                {
+                    auto ctx = make_ref<ExecutionContextObj>(g);
+                    vector<float> in(input->size()), out(output->size());
+                    ctx->bind(input, in.data());
+                    ctx->bind(output, out.data());
+                    for (int iter = 0; iter < 20; ++iter)
+                    {
+                        for (size_t i = 0; i < in.size(); ++i)
+                            in[i] = float(int(i % 7) - 3) * (id + iter + 1);
+                        runtime->run(g, ctx);
+                        for (int r = 0; r < rows; ++r)
+                            for (int i = 0; i < h; ++i)
+                                for (int j = 0; j < w; ++j)
+                                {
+                                    float x = in[(r * h + i) * w + j];
+                                    float y = std::max(x, 0.f) + (j * h + i);
+                                    failures[id] +=
+                                        out[(r * w + j) * h + i] != y;
+                                }
+                    }
+                });
+        for (auto &t : threads)
+            t.join();
+        for (int id = 0; id < workers; ++id)
+            EXPECT_EQ(failures[id], 0);
+    }
+
+    TEST(ExecutionContext, ConcurrentRuns) { runConcurrently(0); }
+
+    TEST(ExecutionContext, ConcurrentTileStreamedRuns) { runConcurrently(1024); }
+
+    TEST(ExecutionContext, OwnsUnboundInputs)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto input = g->addTensor({2, 3}, DataType::Float32);
+        auto output = g->addOp<ReluObj>(input, nullptr)->getOutput();
+        g->dataMalloc();
+        input->setData(ValGenerator<1>());
+
+        auto ctx = make_ref<ExecutionContextObj>(g);
+        ctx->setData(input, IncrementalGenerator());
+        runtime->run(g, ctx);
+        float *out = ctx->getRawDataPtr<float *>(output);
+        EXPECT_EQ(vector<float>(out, out + 6),
+                  (vector<float>{0, 1, 2, 3, 4, 5}));
+        // The graph's own buffers are untouched
+        EXPECT_TRUE(input->equalData(vector<float>(6, 1.f)));
+    }
+} // namespace infini
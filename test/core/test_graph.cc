@@ -1,8 +1,13 @@
+#include "core/execution_context.h"
 #include "core/graph.h"
 #include "core/kernel.h"
 #include "core/runtime.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
 #include "operators/matmul.h"
+#include "operators/quantize.h"
 #include "operators/transpose.h"
+#include "operators/unary.h"
 
 #include "test.h"
 
@@ -37,4 +42,304 @@ namespace infini
         EXPECT_EQ(op->getTransA(), false);
         EXPECT_EQ(op->getTransB(), true);
     }
-}
\ No newline at end of file
+
+    TEST(Graph, RawLinks)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor a = g->addTensor({4, 5}, DataType::Float32);
+        Tensor b = g->addTensor({4, 5}, DataType::Float32);
+        auto trans = g->addOp<TransposeObj>(a, nullptr, vector<int>{1, 0});
+        auto mm = g->addOp<MatmulObj>(trans->getOutput(), b, nullptr);
+
+        EXPECT_EQ(a->getTargetPtrs(), vector<OperatorObj *>{trans.get()});
+        EXPECT_EQ(trans->getOutput()->getSourcePtr(), trans.get());
+        EXPECT_EQ(mm->getPredecessorPtrs(), vector<OperatorObj *>{trans.get()});
+        EXPECT_EQ(trans->getSuccessorPtrs(), vector<OperatorObj *>{mm.get()});
+        // The Ref getters see the same links
+        EXPECT_EQ(a->getTargets(), OpVec{trans});
+        EXPECT_EQ(mm->getPredecessors(), OpVec{trans});
+
+        // A destroyed op unlinks itself from its tensors and neighbours
+        Tensor y = mm->getOutput();
+        g->removeOperator(mm);
+        mm = nullptr;
+        EXPECT_EQ(b->getNumTargets(), 0u);
+        EXPECT_EQ(y->getSourcePtr(), nullptr);
+        EXPECT_TRUE(trans->getSuccessorPtrs().empty());
+    }
+
+    TEST(Graph, ArenaNodes)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor a = g->addTensor({4, 5}, DataType::Float32);
+        const size_t bytes = g->getArena().getAllocatedBytes();
+        EXPECT_GT(bytes, sizeof(TensorObj));
+        auto trans = g->addOp<TransposeObj>(a, nullptr, vector<int>{1, 0});
+        // The op and its output come from the arena too
+        EXPECT_GT(g->getArena().getAllocatedBytes(),
+                  bytes + sizeof(TransposeObj) + sizeof(TensorObj));
+
+        // Nodes keep the arena alive after the graph is gone
+        g = nullptr;
+        EXPECT_EQ(trans->getOutput()->getDims(), (Shape{5, 4}));
+        EXPECT_EQ(a->getTargetPtrs(), vector<OperatorObj *>{trans.get()});
+    }
+
+    TEST(Graph, BulkBuild)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        g->beginBulkBuild();
+        Tensor a = g->addTensor({2, 3}, DataType::Float32);
+        Tensor b = g->addTensor({3, 4}, DataType::Float32);
+        Tensor y = g->addTensor({2, 4}, DataType::Float32);
+        // The consumer may be recorded before the producer of its input
+        Tensor c = g->addTensor({2, 4}, DataType::Float32);
+        auto relu = g->addOpWithOutputs<ReluObj>(c, y);
+        auto mm = g->addOpWithOutputs<MatmulObj>(a, b, c);
+        auto trans = g->addOp<TransposeObj>(y, nullptr, vector<int>{1, 0});
+        EXPECT_EQ(a->getNumTargets(), 0u);
+        EXPECT_EQ(trans->getOutput()->getRank(), 0u);
+        // Rank-dependent attributes of ops on deferred outputs are resolved
+        // at finalize
+        Tensor t = trans->getOutput();
+        auto back = g->addOp<TransposeObj>(t, nullptr, vector<int>{});
+        auto cat = g->addOp<ConcatObj>(TensorVec{t, t}, nullptr, -1);
+        Tensor scale = g->addTensor({4}, DataType::Float32);
+        Tensor zero = g->addTensor({4}, DataType::UInt8);
+        auto quant = g->addOp<QuantizeLinearObj>(back->getOutput(), scale,
+                                                 zero, nullptr, -1);
+
+        g->finalize();
+        EXPECT_FALSE(g->isBulkBuilding());
+        EXPECT_EQ(trans->getOutput()->getDims(), (Shape{4, 2}));
+        EXPECT_EQ(back->getPermute(), (vector<int>{1, 0}));
+        EXPECT_EQ(cat->getDim(), 1);
+        EXPECT_EQ(cat->getOutput()->getDims(), (Shape{4, 4}));
+        EXPECT_EQ(quant->getAxis(), 1);
+        EXPECT_EQ(quant->getOutput()->getDims(), (Shape{2, 4}));
+        EXPECT_EQ(g->getOperators().size(), 6u);
+        EXPECT_EQ(OpVec(g->getOperators().begin(),
+                        g->getOperators().begin() + 3),
+                  (OpVec{mm, relu, trans}));
+        EXPECT_EQ(relu->getPredecessorPtrs(), vector<OperatorObj *>{mm.get()});
+        EXPECT_TRUE(g->checkValid());
+
+        // Given output shapes are checked at finalize
+        Graph bad = make_ref<GraphObj>(runtime);
+        bad->beginBulkBuild();
+        Tensor x = bad->addTensor({2, 3}, DataType::Float32);
+        bad->addOpWithOutputs<ReluObj>(
+            x, bad->addTensor({3, 2}, DataType::Float32));
+        EXPECT_THROW(bad->finalize(), Exception);
+    }
+
+    TEST(Graph, CommonSubexpressions)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        auto build = [&](Graph g)
+        {
+            auto x = g->addTensor({3, 4}, DataType::Float32);
+            auto w = g->addTensor({5, 4}, DataType::Float32);
+            OpVec mms;
+            for (int i = 0; i < 2; ++i)
+            {
+                auto tr = g->addOp<TransposeObj>(w, nullptr, vector<int>{1, 0});
+                mms.emplace_back(
+                    g->addOp<MatmulObj>(x, tr->getOutput(), nullptr));
+            }
+            auto c1 = g->addOp<ClipObj>(mms[0]->getOutput(), nullptr, 0.f, 6.f);
+            auto c2 = g->addOp<ClipObj>(mms[1]->getOutput(), nullptr, 0.f, 6.f);
+            auto c3 = g->addOp<ClipObj>(mms[1]->getOutput(), nullptr, 0.f, 1.f);
+            auto a1 = g->addOp<AddObj>(c1->getOutput(), c2->getOutput(), nullptr);
+            auto a2 = g->addOp<AddObj>(a1->getOutput(), c3->getOutput(), nullptr);
+            g->dataMalloc();
+            x->setData(IncrementalGenerator());
+            w->setData(IncrementalGenerator());
+            runtime->run(g);
+            return a2->getOutput();
+        };
+        Graph ref = make_ref<GraphObj>(runtime);
+        auto expected = build(ref);
+
+        Graph g = make_ref<GraphObj>(runtime);
+        build(g);
+        g->optimize();
+        // One transpose fused into one matmul, the clips with other bounds
+        // and the adds of different inputs are kept
+        EXPECT_EQ(g->getOperators().size(), 5u);
+        EXPECT_TRUE(g->checkValid());
+        g->dataMalloc();
+        auto inputs = g->getInputs();
+        ASSERT_EQ(inputs.size(), 2u);
+        for (auto &t : inputs)
+            t->setData(IncrementalGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(g->getOutputs()[0]->equalData(expected));
+    }
+
+    TEST(Graph, DeadCodeElimination)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({4, 8}, DataType::Float32);
+        auto w1 = g->addTensor({8, 8}, DataType::Float32);
+        auto w2 = g->addTensor({8, 8}, DataType::Float32);
+        auto head1 = g->addOp<ReluObj>(
+            g->addOp<MatmulObj>(x, w1, nullptr)->getOutput(), nullptr);
+        auto head2 = g->addOp<ReluObj>(
+            g->addOp<MatmulObj>(x, w2, nullptr)->getOutput(), nullptr);
+        EXPECT_EQ(g->getOutputs().size(), 2u);
+
+        g->setOutputs({head1->getOutput()});
+        g->optimize();
+        EXPECT_EQ(g->getOperators().size(), 2u);
+        EXPECT_EQ(g->getOutputs(), TensorVec{head1->getOutput()});
+        EXPECT_EQ(g->getInputs(), (TensorVec{x, w1}));
+        EXPECT_TRUE(g->checkValid());
+    }
+
+    TEST(Graph, DanglingTensorsAreNotPinned)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        auto build = [&]
+        {
+            Graph g = make_ref<GraphObj>(runtime);
+            auto x = g->addTensor({64}, DataType::Float32);
+            g->addOp<ReluObj>(x, nullptr);
+            auto b = g->addOp<ReluObj>(x, nullptr);
+            auto c = g->addOp<ReluObj>(b->getOutput(), nullptr);
+            return std::make_pair(g, c->getOutput());
+        };
+        auto [implicit, y1] = build();
+        implicit->dataMalloc();
+        auto [marked, y2] = build();
+        marked->setOutputs({y2});
+        marked->dataMalloc();
+        // The dangling relu output is freed as soon as it is written
+        EXPECT_LT(marked->getArenaBytes(), implicit->getArenaBytes());
+    }
+
+    TEST(Graph, SimplifyAlgebra)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        auto build = [&](Graph g)
+        {
+            auto x = g->addTensor({2, 3, 4}, DataType::Float32);
+            auto clip = g->addOp<ClipObj>(x, nullptr, std::nullopt, std::nullopt);
+            auto cast = g->addOp<CastObj>(clip->getOutput(), nullptr,
+                                          CastType::Float2Float);
+            auto id = g->addOp<TransposeObj>(cast->getOutput(), nullptr,
+                                             vector<int>{0, 1, 2});
+            auto t1 = g->addOp<TransposeObj>(id->getOutput(), nullptr,
+                                             vector<int>{1, 0, 2});
+            auto t2 = g->addOp<TransposeObj>(t1->getOutput(), nullptr,
+                                             vector<int>{0, 2, 1});
+            auto relu = g->addOp<ReluObj>(t2->getOutput(), nullptr);
+            g->dataMalloc();
+            x->setData(IncrementalGenerator());
+            runtime->run(g);
+            return relu->getOutput();
+        };
+        Graph ref = make_ref<GraphObj>(runtime);
+        auto expected = build(ref);
+
+        Graph g = make_ref<GraphObj>(runtime);
+        auto y = build(g);
+        g->optimize();
+        // The no-ops are bypassed and the transposes folded into one
+        ASSERT_EQ(g->getOperators().size(), 2u);
+        auto trans = as<TransposeObj>(g->getOperators()[0]);
+        ASSERT_NE(trans, nullptr);
+        EXPECT_EQ(trans->getPermute(), (vector<int>{1, 2, 0}));
+        EXPECT_TRUE(g->checkValid());
+        g->dataMalloc();
+        g->getInputs()[0]->setData(IncrementalGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(y->equalData(expected));
+
+        // Transposes still referenced by the caller are folded as well
+        Graph k = make_ref<GraphObj>(runtime);
+        auto in = k->addTensor({2, 3}, DataType::Float32);
+        auto first = k->addOp<TransposeObj>(in, nullptr, vector<int>{1, 0});
+        auto second = k->addOp<TransposeObj>(first->getOutput(), nullptr,
+                                             vector<int>{1, 0});
+        k->addOp<ReluObj>(second->getOutput(), nullptr);
+        k->optimize();
+        ASSERT_EQ(k->getOperators().size(), 1u);
+        EXPECT_EQ(k->getOperators()[0]->getInputs(0), in);
+        EXPECT_TRUE(k->checkValid());
+
+        // float16 -> float -> float16 is lossless, float -> float16 is not
+        Graph h = make_ref<GraphObj>(runtime);
+        auto a = h->addTensor({4}, DataType::Float16);
+        auto up = h->addOp<CastObj>(a, nullptr, CastType::Float162Float);
+        auto down = h->addOp<CastObj>(up->getOutput(), nullptr,
+                                      CastType::Float2Float16);
+        auto up2 = h->addOp<CastObj>(down->getOutput(), nullptr,
+                                     CastType::Float162Float);
+        h->addOp<ReluObj>(up2->getOutput(), nullptr);
+        h->optimize();
+        ASSERT_EQ(h->getOperators().size(), 2u);
+        EXPECT_EQ(h->getOperators()[0]->getInputs(0), a);
+    }
+
+    TEST(Graph, ConcatElimination)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x1 = g->addTensor({1, 2, 3}, DataType::Float32);
+        auto x2 = g->addTensor({1, 1, 3}, DataType::Float32);
+        auto a = g->addOp<ReluObj>(x1, nullptr)->getOutput();
+        auto b = g->addOp<ReluObj>(x2, nullptr)->getOutput();
+        auto concat = g->addOp<ConcatObj>(TensorVec{a, b}, nullptr, 1);
+        auto y = g->addOp<ReluObj>(concat->getOutput(), nullptr)->getOutput();
+        g->dataMalloc();
+
+        // The relus write into the slices and the concat is not run
+        auto *base = concat->getOutput()->getRawDataPtr<float *>();
+        EXPECT_EQ(a->getRawDataPtr<float *>(), base);
+        EXPECT_EQ(b->getRawDataPtr<float *>(), base + 6);
+        EXPECT_EQ(std::count(g->getSchedule().begin(), g->getSchedule().end(),
+                             Operator(concat)),
+                  0);
+        x1->setData(IncrementalGenerator());
+        x2->setData(IncrementalGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(y->equalData(vector<float>{0, 1, 2, 3, 4, 5, 0, 1, 2}));
+
+        // Binding the output after dataMalloc moves the slices with it
+        Graph k = make_ref<GraphObj>(runtime);
+        auto k1 = k->addTensor({1, 2, 3}, DataType::Float32);
+        auto k2 = k->addTensor({1, 1, 3}, DataType::Float32);
+        auto cat = k->addOp<ConcatObj>(
+            TensorVec{k->addOp<ReluObj>(k1, nullptr)->getOutput(),
+                      k->addOp<ReluObj>(k2, nullptr)->getOutput()},
+            nullptr, 1);
+        k->dataMalloc();
+        EXPECT_EQ(k->getSchedule().size(), 2u);
+        vector<float> out(9, -7.f);
+        k->bindData(cat->getOutput(), out.data());
+        k1->setData(IncrementalGenerator());
+        k2->setData(IncrementalGenerator());
+        runtime->run(k);
+        EXPECT_EQ(out, (vector<float>{0, 1, 2, 3, 4, 5, 0, 1, 2}));
+
+        // So does binding it in an execution context
+        auto ctx = make_ref<ExecutionContextObj>(k);
+        vector<float> ctxOut(9, -7.f);
+        ctx->bind(cat->getOutput(), ctxOut.data());
+        runtime->run(k, ctx);
+        EXPECT_EQ(ctxOut, out);
+
+        // Slices along an inner axis are strided, the concat copies them
+        Graph h = make_ref<GraphObj>(runtime);
+        auto u = h->addOp<ReluObj>(h->addTensor({2, 3}), nullptr)->getOutput();
+        auto v = h->addOp<ReluObj>(h->addTensor({2, 3}), nullptr)->getOutput();
+        h->addOp<ConcatObj>(TensorVec{u, v}, nullptr, 1);
+        h->dataMalloc();
+        EXPECT_EQ(h->getSchedule().size(), 3u);
+    }
+}
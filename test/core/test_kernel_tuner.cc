@@ -0,0 +1,113 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/kernel_tuner.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/transpose.h"
+
+#include "test.h"
+#include <cstdio>
+#include <fstream>
+
+namespace infini
+{
+    TEST(KernelTuner, CandidatesAgree)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({2, 33, 20}, DataType::Float32);
+        auto b = g->addTensor({20, 7}, DataType::Float32);
+        auto mm = g->addOp<MatmulObj>(a, b, nullptr);
+        auto trans = g->addOp<TransposeObj>(mm->getOutput(), nullptr,
+                                            vector<int>{2, 0, 1});
+        g->dataMalloc();
+        // Inputs may share memory with later activations, refill every run
+        auto run = [&]
+        {
+            a->setData(IncrementalGenerator());
+            b->setData(IncrementalGenerator());
+            runtime->run(g);
+        };
+        run();
+        auto y = trans->getOutput();
+        auto ptr = y->getRawDataPtr<float *>();
+        vector<float> expected(ptr, ptr + y->size());
+
+        auto &registry = KernelRegistry::getInstance();
+        for (auto &op : {Operator(mm), Operator(trans)})
+        {
+            auto &candidates =
+                registry.getKernelCandidates(getKernelAttrs(Device::CPU, op));
+            EXPECT_GT(candidates.size(), 1u);
+            for (auto &record : candidates)
+            {
+                op->setKernel(std::get<0>(record));
+                std::fill(ptr, ptr + y->size(), 0.f);
+                run();
+                EXPECT_TRUE(y->equalData(expected)) << std::get<1>(record);
+            }
+            op->setKernel(nullptr);
+        }
+    }
+
+    TEST(KernelTuner, PersistsWinners)
+    {
+        const string cache = "kernel_tuner_cache.txt";
+        std::remove(cache.c_str());
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({16, 16}, DataType::Float32);
+        auto b = g->addTensor({16, 16}, DataType::Float32);
+        auto mm = g->addOp<MatmulObj>(a, b, nullptr);
+        g->setKernelTuner(make_ref<KernelTuner>(cache));
+        g->dataMalloc();
+        EXPECT_NE(mm->getKernel(), nullptr);
+
+        // One result per line: signature and kernel name
+        std::ifstream in(cache);
+        string key, name;
+        ASSERT_TRUE(in >> key >> name);
+        EXPECT_EQ(key, KernelTuner::signature(mm, Device::CPU));
+        in.close();
+
+        // A recorded winner is used without timing
+        std::ofstream(cache) << key << " MatmulParallel_CPU\n";
+        g->setKernelTuner(make_ref<KernelTuner>(cache));
+        g->dataMalloc();
+        Kernel *parallel = nullptr;
+        for (auto &record : KernelRegistry::getInstance().getKernelCandidates(
+                 getKernelAttrs(Device::CPU, mm)))
+            if (std::get<1>(record) == "MatmulParallel_CPU")
+                parallel = std::get<0>(record);
+        EXPECT_EQ(mm->getKernel(), parallel);
+        std::remove(cache.c_str());
+    }
+
+    TEST(KernelTuner, SignatureHasAttributes)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({4, 4, 4}, DataType::Float32);
+        auto t1 = g->addOp<TransposeObj>(x, nullptr, vector<int>{2, 0, 1});
+        auto t2 = g->addOp<TransposeObj>(x, nullptr, vector<int>{1, 2, 0});
+        // Same shapes, other permutations
+        EXPECT_NE(KernelTuner::signature(t1, Device::CPU),
+                  KernelTuner::signature(t2, Device::CPU));
+    }
+
+    TEST(KernelTuner, LeavesDataUntouched)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({4, 4, 4}, DataType::Float32);
+        auto trans = g->addOp<TransposeObj>(x, nullptr, vector<int>{2, 0, 1});
+        // Timing does not write into buffers bound by the caller
+        vector<float> input(64, 1.f), output(64, -1.f);
+        g->bindData(x, input.data());
+        g->bindData(trans->getOutput(), output.data());
+        g->setKernelTuner(make_ref<KernelTuner>());
+        g->dataMalloc();
+        EXPECT_EQ(output, vector<float>(64, -1.f));
+        EXPECT_EQ(input, vector<float>(64, 1.f));
+    }
+} // namespace infini
@@ -0,0 +1,96 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(PlanCache, ReshapeReusesPlans)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({2, 8}, DataType::Float32);
+        auto w = g->addTensor({8, 4}, DataType::Float32);
+        auto mm = g->addOp<MatmulObj>(x, w, nullptr);
+        auto y = g->addOp<ReluObj>(mm->getOutput(), nullptr)->getOutput();
+        g->dataMalloc();
+        w->setData(OneGenerator());
+        g->setPlanCache(4, {4, 16});
+
+        auto check = [&](int rows)
+        {
+            x->setData(IncrementalGenerator());
+            runtime->run(g);
+            vector<float> ans;
+            for (int i = 0; i < rows; ++i)
+                for (int j = 0; j < 4; ++j)
+                    ans.emplace_back(64.f * i + 28.f);
+            EXPECT_TRUE(y->equalData(ans));
+        };
+
+        // 3 rows are padded up to the bucket of 4; the weight is carried over
+        EXPECT_EQ(g->reshape({{3, 8}, {8, 4}}),
+                  (vector<Shape>{{4, 8}, {8, 4}}));
+        EXPECT_EQ(y->getDims(), (Shape{4, 4}));
+        check(4);
+        void *bucket4 = g->getArenaBase();
+
+        EXPECT_EQ(g->reshape({{16, 8}, {8, 4}})[0], (Shape{16, 8}));
+        check(16);
+
+        // The original shape is not dynamic and is never padded
+        EXPECT_EQ(g->reshape({{2, 8}, {8, 4}})[0], (Shape{2, 8}));
+        check(2);
+
+        // Switching back is a lookup: same memory, no replan
+        EXPECT_EQ(g->reshape({{4, 8}, {8, 4}})[0], (Shape{4, 8}));
+        EXPECT_EQ(g->getArenaBase(), bucket4);
+        check(4);
+    }
+
+    TEST(PlanCache, EvictsLeastRecentlyUsed)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({1, 8}, DataType::Float32);
+        auto y = g->addOp<ReluObj>(x, nullptr)->getOutput();
+        g->dataMalloc();
+        g->setPlanCache(2);
+
+        for (int rows : {2, 3, 4, 2})
+        {
+            g->reshape({{rows, 8}});
+            x->setData(IncrementalGenerator());
+            runtime->run(g);
+            EXPECT_EQ(y->getDims(), (Shape{rows, 8}));
+            EXPECT_TRUE(y->equalData(x));
+        }
+    }
+
+    TEST(PlanCache, WeightsSharedByPlans)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({2, 8}, DataType::Float32);
+        auto w = g->addTensor({8, 4}, DataType::Float32);
+        auto y = g->addOp<MatmulObj>(x, w, nullptr)->getOutput();
+        g->dataMalloc();
+        w->setData(OneGenerator());
+        g->setPlanCache(4);
+
+        g->reshape({{4, 8}, {8, 4}});
+        auto *weights = w->getRawDataPtr<float *>();
+        g->reshape({{2, 8}, {8, 4}});
+        EXPECT_EQ(w->getRawDataPtr<float *>(), weights);
+
+        // A weight updated under one plan is seen by the others
+        w->setData(ZeroGenerator());
+        g->reshape({{4, 8}, {8, 4}});
+        x->setData(OneGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(y->equalData(vector<float>(16, 0.f)));
+    }
+} // namespace infini
@@ -0,0 +1,44 @@
+#include "core/tensor.h"
+#include "utils/small_vector.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(SmallVector, InlineAndHeap)
+    {
+        SmallVector<int, 4> v{1, 2, 3};
+        EXPECT_EQ(v.capacity(), 4u);
+        for (int i = 4; i <= 10; ++i)
+            v.push_back(i);
+        EXPECT_GT(v.capacity(), 4u);
+        EXPECT_EQ(v.size(), 10u);
+        EXPECT_EQ(v.back(), 10);
+
+        // Moving a heap vector steals its buffer, an inline one is copied
+        auto stolen = std::move(v);
+        EXPECT_EQ(stolen.size(), 10u);
+        EXPECT_TRUE(v.empty());
+        SmallVector<int, 4> small{7, 8};
+        auto copied = std::move(small);
+        EXPECT_EQ(copied, (SmallVector<int, 4>{7, 8}));
+
+        stolen.erase(stolen.begin() + 1, stolen.begin() + 9);
+        EXPECT_EQ(stolen, (SmallVector<int, 4>{1, 10}));
+        stolen.insert(stolen.begin() + 1, 3, 0);
+        stolen.insert(stolen.begin(), copied.begin(), copied.end());
+        EXPECT_EQ(stolen, (SmallVector<int, 4>{7, 8, 1, 0, 0, 0, 10}));
+        EXPECT_LT(copied, stolen);
+    }
+
+    TEST(SmallVector, ShapeConvertsToVector)
+    {
+        Shape shape(3, 2);
+        shape[1] = 5;
+        vector<int> v = shape;
+        EXPECT_EQ(v, (vector<int>{2, 5, 2}));
+        EXPECT_EQ(Shape(v), shape);
+        EXPECT_EQ(Shape(shape.rbegin(), shape.rend()), (Shape{2, 5, 2}));
+        EXPECT_EQ(vecToString(shape), "[2,5,2]");
+    }
+} // namespace infini
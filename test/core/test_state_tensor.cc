@@ -0,0 +1,90 @@
+#include "core/execution_context.h"
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/append.h"
+#include "operators/concat.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    // One decode step of attention scores: the key of the new token is
+    // appended to a cache and the query is scored against all cached keys.
+    TEST(StateTensor, AppendsAcrossRuns)
+    {
+        const int dim = 4, capacity = 6;
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto cache = g->addState({0, dim}, DataType::Float32, 0, capacity);
+        auto key = g->addTensor({1, dim}, DataType::Float32);
+        auto query = g->addTensor({1, dim}, DataType::Float32);
+        auto keys = g->addOp<AppendObj>(cache, key, nullptr, 0)->getOutput();
+        auto scores =
+            g->addOp<MatmulObj>(query, keys, nullptr, false, true)->getOutput();
+        g->dataMalloc();
+        query->setData(OneGenerator());
+        // Contexts would share the cache
+        EXPECT_THROW(make_ref<ExecutionContextObj>(g), Exception);
+
+        for (int step = 0; step < capacity; ++step)
+        {
+            EXPECT_EQ(cache->getDims(), (Shape{step, dim}));
+            EXPECT_EQ(scores->getDims(), (Shape{1, step + 1}));
+            key->setData([&](void *ptr, size_t size, DataType)
+                         { std::fill_n(static_cast<float *>(ptr), size, float(step)); });
+            runtime->run(g);
+
+            vector<float> ans;
+            for (int i = 0; i <= step; ++i)
+                ans.emplace_back(float(dim * i));
+            EXPECT_TRUE(scores->equalData(ans));
+            // The row of the last step is kept, and the graph reports that
+            // the next one does not fit
+            EXPECT_EQ(g->advanceStates(), step + 1 < capacity);
+        }
+        EXPECT_EQ(cache->getDims(), (Shape{capacity, dim}));
+        EXPECT_TRUE(g->statesFull());
+        EXPECT_THROW(runtime->run(g), Exception);
+        EXPECT_THROW(g->advanceStates(), Exception);
+
+        g->resetStates();
+        EXPECT_EQ(cache->getDims(), (Shape{0, dim}));
+        EXPECT_EQ(scores->getDims(), (Shape{1, 1}));
+    }
+
+    // Memory is planned for full states, so a Concat whose inputs follow a
+    // state length can not have them written in place
+    TEST(StateTensor, ConcatOfStateDependentInputs)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto cache = g->addState({0, 2}, DataType::Float32, 0, 4);
+        auto key = g->addTensor({1, 2}, DataType::Float32);
+        auto query = g->addTensor({1, 2}, DataType::Float32);
+        auto extra = g->addTensor({1, 2}, DataType::Float32);
+        auto keys = g->addOp<AppendObj>(cache, key, nullptr, 0)->getOutput();
+        auto scores =
+            g->addOp<MatmulObj>(query, keys, nullptr, false, true)->getOutput();
+        auto relu = g->addOp<ReluObj>(extra, nullptr)->getOutput();
+        auto y = g->addOp<ConcatObj>(TensorVec{scores, relu}, nullptr, 1)
+                     ->getOutput();
+        g->dataMalloc();
+        // Inputs may share memory with later activations, refill every run
+        auto run = [&]
+        {
+            query->setData(OneGenerator());
+            key->setData(OneGenerator());
+            extra->setData([](void *ptr, size_t size, DataType)
+                           { std::fill_n(static_cast<float *>(ptr), size, 9.f); });
+            runtime->run(g);
+        };
+        run();
+        EXPECT_TRUE(y->equalData(vector<float>{2, 9, 9}));
+        g->advanceStates();
+        run();
+        EXPECT_TRUE(y->equalData(vector<float>{2, 2, 9, 9}));
+    }
+} // namespace infini
@@ -0,0 +1,83 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(DimExpr, Algebra)
+    {
+        DimExpr seq("seq"), batch("batch");
+        auto e = seq * 2 + 1;
+        EXPECT_EQ(e, 1 + seq + seq);
+        EXPECT_FALSE(e.isConstant());
+        EXPECT_EQ(e.evaluate({{"seq", 5}}), 11);
+        EXPECT_EQ((batch * seq + seq * (-1) * batch).getConstant(), 0);
+        EXPECT_EQ((batch * seq * 4).evaluate({{"batch", 2}, {"seq", 3}}), 24);
+        EXPECT_EQ(DimExpr(7).getConstant(), 7);
+    }
+
+    // x (batch, seq, 8) * w (8, 4) -> transpose -> concat with its relu
+    static Tensor buildGraph(Graph g, Tensor x, Tensor &w)
+    {
+        w = g->addTensor({8, 4}, DataType::Float32);
+        auto mm = g->addOp<MatmulObj>(x, w, nullptr);
+        auto trans = g->addOp<TransposeObj>(mm->getOutput(), nullptr,
+                                            vector<int>{0, 2, 1});
+        auto relu = g->addOp<ReluObj>(trans->getOutput(), nullptr);
+        return g->addOp<ConcatObj>(
+                    TensorVec{trans->getOutput(), relu->getOutput()}, nullptr, 2)
+            ->getOutput();
+    }
+
+    TEST(SymbolicShape, OnePlanForAllSizes)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        DimExpr batch("batch"), seq("seq");
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addSymTensor({batch, seq, 8}, DataType::Float32);
+        Tensor w;
+        auto y = buildGraph(g, x, w);
+        g->symbolicDataMalloc();
+        EXPECT_EQ(y->getSymShape(), (SymShape{batch, 4, seq * 2}));
+
+        bool weightsSet = false;
+        for (auto [b, s] : {std::pair{2, 3}, std::pair{1, 7}, std::pair{2, 1}})
+        {
+            g->bindSymbols({{"batch", b}, {"seq", s}});
+            EXPECT_EQ(y->getDims(), (Shape{b, 4, 2 * s}));
+            // Weights survive rebinding, even when the arena grows
+            if (!weightsSet)
+                w->setData(IncrementalGenerator());
+            weightsSet = true;
+            x->setData(IncrementalGenerator());
+            runtime->run(g);
+
+            Graph ref = make_ref<GraphObj>(runtime);
+            auto refX = ref->addTensor({b, s, 8}, DataType::Float32);
+            Tensor refW;
+            auto refY = buildGraph(ref, refX, refW);
+            ref->dataMalloc();
+            refX->setData(IncrementalGenerator());
+            refW->setData(IncrementalGenerator());
+            runtime->run(ref);
+            EXPECT_TRUE(y->equalData(refY));
+        }
+    }
+
+    TEST(SymbolicShape, UndecidableBroadcastFails)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addSymTensor({DimExpr("m"), 4}, DataType::Float32);
+        auto b = g->addSymTensor({DimExpr("n"), 4}, DataType::Float32);
+        g->addOp<AddObj>(a, b, nullptr);
+        EXPECT_THROW(g->symbolicDataMalloc(), Exception);
+    }
+} // namespace infini
@@ -0,0 +1,63 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    // Relu -> Transpose -> Add, with the bias broadcast along the outer dim
+    static Tensor buildChain(Graph g, Tensor &input, Tensor &bias)
+    {
+        input = g->addTensor({64, 4, 8}, DataType::Float32);
+        bias = g->addTensor({8, 4}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(input, nullptr);
+        auto trans =
+            g->addOp<TransposeObj>(relu->getOutput(), nullptr, Shape{0, 2, 1});
+        auto add = g->addOp<AddObj>(trans->getOutput(), bias, nullptr);
+        return add->getOutput();
+    }
+
+    TEST(TileStream, MatchesUntiled)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+
+        Graph ref = make_ref<GraphObj>(runtime);
+        Tensor refInput, refBias;
+        auto refOutput = buildChain(ref, refInput, refBias);
+        ref->dataMalloc();
+        refInput->setData(IncrementalGenerator());
+        refBias->setData(IncrementalGenerator());
+        runtime->run(ref);
+
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor input, bias;
+        auto output = buildChain(g, input, bias);
+        // One row of the chain touches 4 tensors of 128 bytes
+        g->setTileStreaming(1024);
+        g->dataMalloc();
+        input->setData(IncrementalGenerator());
+        bias->setData(IncrementalGenerator());
+        runtime->run(g);
+
+        EXPECT_EQ(g->getOperators().size(), 3);
+        EXPECT_EQ(g->getSchedule().size(), 3 * 32);
+        EXPECT_TRUE(output->equalData(refOutput));
+    }
+
+    TEST(TileStream, SkipsUnsplittableOps)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto input = g->addTensor({16, 8}, DataType::Float32);
+        // Moving the outer dimension breaks the chain
+        auto trans = g->addOp<TransposeObj>(input, nullptr, Shape{1, 0});
+        g->addOp<ReluObj>(trans->getOutput(), nullptr);
+        g->setTileStreaming(64);
+        g->dataMalloc();
+        EXPECT_EQ(g->getSchedule().size(), 2);
+    }
+} // namespace infini
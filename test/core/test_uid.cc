@@ -0,0 +1,53 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+
+#include "test.h"
+#include <thread>
+
+namespace infini
+{
+    TEST(Uid, ParallelGraphBuilding)
+    {
+        const int nThreads = 4, nLayers = 200;
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        vector<Graph> graphs(nThreads);
+        vector<std::thread> threads;
+        for (int i = 0; i < nThreads; ++i)
+            threads.emplace_back(
+                [&, i]
+                {
+                    Graph g = make_ref<GraphObj>(runtime);
+                    auto x = g->addTensor({2, 8}, DataType::Float32);
+                    auto w = g->addTensor({8, 8}, DataType::Float32);
+                    for (int l = 0; l < nLayers; ++l)
+                    {
+                        auto mm = g->addOp<MatmulObj>(x, w, nullptr);
+                        x = g->addOp<ReluObj>(mm->getOutput(), nullptr)
+                                ->getOutput();
+                    }
+                    g->dataMalloc();
+                    graphs[i] = g;
+                });
+        for (auto &t : threads)
+            t.join();
+
+        std::set<UidBaseType> guids, fuids;
+        size_t nNodes = 0;
+        for (auto &g : graphs)
+        {
+            for (auto &t : g->getTensors())
+            {
+                guids.insert(t->getGuid());
+                fuids.insert(t->getFuid());
+            }
+            for (auto &op : g->getOperators())
+                guids.insert(op->getGuid());
+            nNodes += g->getTensors().size() + g->getOperators().size();
+        }
+        EXPECT_EQ(guids.size(), nNodes);
+        EXPECT_EQ(fuids.size(), nNodes - nThreads * 2 * nLayers);
+    }
+} // namespace infini
@@ -0,0 +1,106 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+#include "utils/float16.h"
+
+#include "test.h"
+
+namespace infini {
+
+template <typename S, typename D>
+void testCastNativeCpu(CastType castType, DataType inputType,
+                       const vector<S> &input, const vector<D> &expected) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto t = g->addTensor({(int)input.size()}, inputType);
+    auto op = g->addOp<CastObj>(t, nullptr, castType);
+    g->dataMalloc();
+    t->setData([&](void *ptr, size_t size, DataType) {
+        std::memcpy(ptr, input.data(), size * sizeof(S));
+    });
+
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(expected));
+}
+
+TEST(Cast, Float16) {
+    // 9 elements exercise both the vector body and the scalar tail
+    vector<float> input{1.f,     -2.f,   65504.f, 1e6f,  0.1f,
+                        6e-8f,   -0.f,   1.f / 3, 2049.f};
+    vector<uint16_t> half{0x3C00, 0xC000, 0x7BFF, 0x7C00, 0x2E66,
+                          0x0001, 0x8000, 0x3555, 0x6800};
+    for (size_t i = 0; i < input.size(); ++i)
+        EXPECT_EQ(fp32_to_fp16(input[i]), half[i]);
+    testCastNativeCpu(CastType::Float2Float16, DataType::Float32, input, half);
+
+    vector<float> back;
+    for (auto h : half)
+        back.emplace_back(fp16_to_fp32(h));
+    EXPECT_EQ(back[0], 1.f);
+    EXPECT_EQ(back[2], 65504.f);
+    testCastNativeCpu(CastType::Float162Float, DataType::Float16, half, back);
+}
+
+TEST(Cast, Float16NaN) {
+    // Quieted, sign and top payload bits kept, by the vector body and the
+    // scalar tail alike
+    vector<uint32_t> bits{0x7FC00000, 0xFFC00000, 0x7FC02000,
+                          0x7F802000, 0x7FFFFFFF, 0xFF800001,
+                          0x7FA00000, 0xFFE00000, 0x7FC3E000};
+    vector<uint16_t> half{0x7E00, 0xFE00, 0x7E01, 0x7E01, 0x7FFF,
+                          0xFE00, 0x7F00, 0xFF00, 0x7E1F};
+    vector<float> input;
+    for (auto b : bits)
+        input.emplace_back(fp32_from_bits(b));
+    for (size_t i = 0; i < input.size(); ++i)
+        EXPECT_EQ(fp32_to_fp16(input[i]), half[i]) << i;
+    testCastNativeCpu(CastType::Float2Float16, DataType::Float32, input, half);
+    EXPECT_EQ(fp32_to_bits(fp16_to_fp32(0xFE01)), 0xFFC02000u);
+}
+
+TEST(Cast, BFloat16) {
+    vector<uint32_t> bits{0x3F808000, 0x3F818000, 0x3F808001, 0x7FC00001,
+                          0xFF800000, 0x00000001, 0x3F800000, 0xC0490FDB,
+                          0x3F817FFF};
+    vector<uint16_t> bf16{0x3F80, 0x3F82, 0x3F81, 0x7FC0, 0xFF80,
+                          0x0000, 0x3F80, 0xC049, 0x3F81};
+    vector<float> input;
+    for (auto b : bits)
+        input.emplace_back(fp32_from_bits(b));
+    testCastNativeCpu(CastType::Float2BFloat16, DataType::Float32, input, bf16);
+
+    vector<float> back;
+    for (auto b : bf16)
+        back.emplace_back(bf16_to_fp32(b));
+    back[3] = 0; // NaN never compares equal
+    vector<uint16_t> finite = bf16;
+    finite[3] = 0;
+    testCastNativeCpu(CastType::BFloat162Float, DataType::BFloat16, finite,
+                      back);
+}
+
+TEST(Cast, SaturatingNarrowing) {
+    vector<float> input{300.f, -300.f, 2.7f, -2.7f, 127.5f,
+                        -128.5f, 0.f, NAN, 1e10f};
+    testCastNativeCpu(CastType::Float2Int8, DataType::Float32, input,
+                      vector<int8_t>{127, -128, 2, -2, 127, -128, 0, 0, 127});
+    testCastNativeCpu(
+        CastType::Float2Int32, DataType::Float32, input,
+        vector<int32_t>{300, -300, 2, -2, 127, -128, 0, 0, 2147483647});
+    testCastNativeCpu(
+        CastType::Int322Int16, DataType::Int32,
+        vector<int32_t>{40000, -40000, 5, -5, 32767, -32768, 0, 1, 70000},
+        vector<int16_t>{32767, -32768, 5, -5, 32767, -32768, 0, 1, 32767});
+    testCastNativeCpu(CastType::Int642Uint32, DataType::Int64,
+                      vector<int64_t>{-1, 5, 1ll << 40},
+                      vector<uint32_t>{0, 5, 4294967295u});
+    testCastNativeCpu(CastType::Int642Float, DataType::Int64,
+                      vector<int64_t>{-3, 1ll << 40},
+                      vector<float>{-3.f, 1099511627776.f});
+    testCastNativeCpu(CastType::Uint82Float, DataType::UInt8,
+                      vector<uint8_t>{0, 1, 2, 3, 4, 5, 6, 7, 255},
+                      vector<float>{0, 1, 2, 3, 4, 5, 6, 7, 255});
+}
+
+} // namespace infini
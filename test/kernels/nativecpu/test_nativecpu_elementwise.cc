@@ -1,4 +1,5 @@
 #include "core/graph.h"
+#include "core/kernel.h"
 #include "core/runtime.h"
 #include "operators/element_wise.h"
 
@@ -41,4 +42,59 @@ TEST(ElementWise, NativeCpu) {
         Shape{2, 1, 1}, ExpectOutput{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
 }
 
+TEST(ElementWise, NativeCpuFloat16) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    for (auto dataType : {DataType::Float16, DataType::BFloat16}) {
+        Graph g = make_ref<GraphObj>(runtime);
+        auto t1 = g->addTensor({2, 3}, dataType);
+        auto t2 = g->addTensor({3}, dataType);
+        auto op = g->addOp<MulObj>(t1, t2, nullptr);
+        g->dataMalloc();
+        t1->setData(IncrementalGenerator());
+        t2->setData(IncrementalGenerator());
+
+        runtime->run(g);
+        // 16-bit storage: compare the bit patterns of {0, 1, 4, 0, 4, 10}
+        vector<uint16_t> ans;
+        for (float v : {0.f, 1.f, 4.f, 0.f, 4.f, 10.f})
+            ans.emplace_back(dataType == DataType::Float16 ? fp32_to_fp16(v)
+                                                           : fp32_to_bf16(v));
+        EXPECT_TRUE(op->getOutput()->equalData(ans));
+    }
+}
+
+template <typename T> void testElementWiseTyped(DataType dataType) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto t1 = g->addTensor({2, 3}, dataType);
+    auto t2 = g->addTensor({3}, dataType);
+    auto op = g->addOp<SubObj>(t1, t2, nullptr);
+    g->dataMalloc();
+    // The kernel is picked for the dtype at plan time
+    EXPECT_EQ(op->getKernel(),
+              KernelRegistry::getInstance().getKernel(
+                  KernelAttrs{Device::CPU, OpType::Sub, dataType}));
+    t1->setData([](void *ptr, size_t size, DataType) {
+        for (size_t i = 0; i < size; ++i)
+            static_cast<T *>(ptr)[i] = T(i * 10);
+    });
+    t2->setData([](void *ptr, size_t size, DataType) {
+        for (size_t i = 0; i < size; ++i)
+            static_cast<T *>(ptr)[i] = T(i);
+    });
+
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(vector<T>{0, 9, 18, 30, 39, 48}));
+}
+
+TEST(ElementWise, NativeCpuTyped) {
+    testElementWiseTyped<double>(DataType::Double);
+    testElementWiseTyped<int32_t>(DataType::Int32);
+    testElementWiseTyped<int64_t>(DataType::Int64);
+    // No kernel for the dtype: found neither typed nor for every dtype
+    EXPECT_EQ(KernelRegistry::getInstance().findKernelCandidates(
+                  KernelAttrs{Device::CPU, OpType::Add, DataType::Bool}),
+              nullptr);
+}
+
 } // namespace infini
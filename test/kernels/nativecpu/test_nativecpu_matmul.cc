@@ -0,0 +1,52 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+
+#include "test.h"
+
+namespace infini {
+
+// Results of incremental inputs are small integers, which are exact in every
+// floating point type tested here.
+void testMatmulNativeCpu(DataType dataType, const Shape &shapeA,
+                         const Shape &shapeB, bool transA, bool transB,
+                         const vector<float> &ansVec) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor(shapeA, dataType);
+    auto b = g->addTensor(shapeB, dataType);
+    auto op = g->addOp<MatmulObj>(a, b, nullptr, transA, transB);
+    auto expected = g->addTensor(op->getOutput()->getDims(), dataType);
+    g->dataMalloc();
+    a->setData(IncrementalGenerator());
+    b->setData(IncrementalGenerator());
+    expected->setData([&](void *ptr, size_t size, DataType dt) {
+        for (size_t i = 0; i < size; ++i) {
+            if (dt == DataType::Float32)
+                reinterpret_cast<float *>(ptr)[i] = ansVec[i];
+            else if (dt == DataType::Float16)
+                reinterpret_cast<uint16_t *>(ptr)[i] = fp32_to_fp16(ansVec[i]);
+            else
+                reinterpret_cast<uint16_t *>(ptr)[i] = fp32_to_bf16(ansVec[i]);
+        }
+    });
+
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(expected));
+}
+
+TEST(Matmul, NativeCpu) {
+    for (auto dataType :
+         {DataType::Float32, DataType::Float16, DataType::BFloat16}) {
+        testMatmulNativeCpu(dataType, Shape{2, 3}, Shape{3, 2}, false, false,
+                            vector<float>{10, 13, 28, 40});
+        testMatmulNativeCpu(dataType, Shape{3, 2}, Shape{2, 3}, true, true,
+                            vector<float>{10, 28, 13, 40});
+        // B is broadcast over the batch of A
+        testMatmulNativeCpu(dataType, Shape{2, 1, 2}, Shape{2, 2}, false,
+                            false, vector<float>{2, 3, 6, 11});
+    }
+}
+
+} // namespace infini
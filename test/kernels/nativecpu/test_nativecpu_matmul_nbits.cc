@@ -0,0 +1,73 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/matmul_nbits.h"
+
+#include "test.h"
+
+namespace infini {
+
+template <typename T> void copyIn(const Tensor &t, const vector<T> &data) {
+    t->setData([&](void *ptr, size_t size, DataType) {
+        IT_ASSERT(size == data.size());
+        std::memcpy(ptr, data.data(), size * sizeof(T));
+    });
+}
+
+// Every group, including the partial last one, holds a value of magnitude
+// maxQ * scale with a power-of-two scale, so packing is lossless and the
+// result can be compared with a plain float matmul.
+void testMatMulNBits(int bits, int groupSize) {
+    const int k = 40, n = 5;
+    const int maxQ = bits == 8 ? 127 : 7;
+    vector<float> w(k * n), colScale{0.5f, 0.25f, 1.f, 0.125f, 2.f};
+    for (int p = 0; p < k; ++p)
+        for (int j = 0; j < n; ++j) {
+            int q = p % groupSize == 0 ? maxQ
+                                       : (p * 7 + j * 3) % (2 * maxQ + 1) - maxQ;
+            w[p * n + j] = q * colScale[j];
+        }
+    const int groups = (k + groupSize - 1) / groupSize;
+    vector<uint8_t> packed(n * groups * groupSize * bits / 8);
+    vector<float> scales(n * groups);
+    MatMulNBitsObj::packWeight(w.data(), k, n, bits, groupSize, packed.data(),
+                               scales.data());
+
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({2, 3, k}, DataType::Float32);
+    auto b = g->addTensor(MatMulNBitsObj::packedShape(k, n, bits, groupSize),
+                          DataType::UInt8);
+    auto s = g->addTensor(MatMulNBitsObj::scalesShape(k, n, groupSize),
+                          DataType::Float32);
+    auto op = g->addOp<MatMulNBitsObj>(a, b, s, nullptr, bits, groupSize);
+    EXPECT_EQ(op->getOutput()->getDims(), (Shape{2, 3, n}));
+    g->dataMalloc();
+
+    vector<float> aData(a->size());
+    for (size_t i = 0; i < aData.size(); ++i)
+        aData[i] = float(int(i * 5 % 17) - 8) * 0.5f;
+    copyIn(a, aData);
+    copyIn(b, packed);
+    copyIn(s, scales);
+    runtime->run(g);
+
+    vector<float> ans(6 * n, 0.f);
+    for (int i = 0; i < 6; ++i)
+        for (int j = 0; j < n; ++j)
+            for (int p = 0; p < k; ++p)
+                ans[i * n + j] += aData[i * k + p] * w[p * n + j];
+    EXPECT_TRUE(op->getOutput()->equalData(ans));
+}
+
+TEST(MatMulNBits, Int4) {
+    testMatMulNBits(4, 16);
+    testMatMulNBits(4, 32);
+}
+
+TEST(MatMulNBits, Int8) {
+    testMatMulNBits(8, 16);
+    testMatMulNBits(8, 64);
+}
+
+} // namespace infini
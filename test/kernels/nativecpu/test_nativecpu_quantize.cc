@@ -0,0 +1,154 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/quantize.h"
+
+#include "test.h"
+
+namespace infini {
+
+template <typename T> void copyIn(const Tensor &t, const vector<T> &data) {
+    t->setData([&](void *ptr, size_t size, DataType) {
+        IT_ASSERT(size == data.size());
+        std::memcpy(ptr, data.data(), size * sizeof(T));
+    });
+}
+
+TEST(QuantizeLinear, NativeCpu) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({2, 3}, DataType::Float32);
+    auto scale = g->addTensor({3}, DataType::Float32);
+    auto zero = g->addTensor({3}, DataType::UInt8);
+    auto q = g->addOp<QuantizeLinearObj>(x, scale, zero, nullptr, 1);
+    auto dq = g->addOp<DequantizeLinearObj>(q->getOutput(), scale, zero,
+                                            nullptr, 1);
+    EXPECT_EQ(q->getOutDType(), DataType::UInt8);
+    g->dataMalloc();
+    copyIn<float>(x, {0.5f, 1.5f, -3.f, 100.f, -2.5f, 2.f});
+    copyIn<float>(scale, {1.f, 1.f, 0.5f});
+    copyIn<uint8_t>(zero, {0, 128, 10});
+
+    runtime->run(g);
+    // Half to even: 0.5 -> 0, 1.5 -> 2, -2.5 -> -2; -6 + 10 -> 4
+    EXPECT_TRUE(q->getOutput()->equalData(
+        vector<uint8_t>{0, 130, 4, 100, 126, 14}));
+    EXPECT_TRUE(dq->getOutput()->equalData(
+        vector<float>{0.f, 2.f, -3.f, 100.f, -2.f, 2.f}));
+}
+
+// A per-tensor scale ignores the axis, which may not exist in a 1-D input
+TEST(QuantizeLinear, PerTensor1D) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({4}, DataType::Float32);
+    auto scale = g->addTensor({1}, DataType::Float32);
+    auto zero = g->addTensor({1}, DataType::Int8);
+    auto q = g->addOp<QuantizeLinearObj>(x, scale, zero, nullptr);
+    auto dq = g->addOp<DequantizeLinearObj>(q->getOutput(), scale, zero,
+                                            nullptr);
+    g->dataMalloc();
+    copyIn<float>(x, {-1.f, 0.f, 2.f, 300.f});
+    copyIn<float>(scale, {0.5f});
+    copyIn<int8_t>(zero, {1});
+    runtime->run(g);
+    EXPECT_TRUE(q->getOutput()->equalData(vector<int8_t>{-1, 1, 5, 127}));
+    EXPECT_TRUE(dq->getOutput()->equalData(vector<float>{-1.f, 0.f, 2.f, 63.f}));
+
+    // A per-axis scale still needs a valid axis
+    Graph bad = make_ref<GraphObj>(runtime);
+    auto y = bad->addTensor({4}, DataType::Float32);
+    auto scales = bad->addTensor({4}, DataType::Float32);
+    auto zeros = bad->addTensor({4}, DataType::Int8);
+    EXPECT_THROW(bad->addOp<QuantizeLinearObj>(y, scales, zeros, nullptr),
+                 Exception);
+    EXPECT_NO_THROW(bad->addOp<QuantizeLinearObj>(y, scales, zeros, nullptr, 0));
+}
+
+// dequantize -> MatMul -> quantize, folded or not by optimize(). Scales are
+// powers of two, so both paths are exact and must agree bit for bit. The
+// graph is returned as well since it owns the output memory. m and n are
+// not multiples of the kernel tile.
+const int qmmK = 40, qmmN = 5;
+
+vector<int8_t> quantizedWeights(int seed) {
+    vector<int8_t> bData(qmmK * qmmN);
+    for (int i = 0; i < qmmK * qmmN; ++i)
+        bData[i] = int8_t(i * seed % 200 - 100);
+    return bData;
+}
+
+template <typename TA>
+std::pair<Graph, Tensor> runQuantizedMatmul(bool optimize, DataType aType,
+                                            int bSeed = 13) {
+    const int m = 3, k = qmmK, n = qmmN;
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({m, k}, aType);
+    auto aScale = g->addTensor({1}, DataType::Float32);
+    auto aZero = g->addTensor({1}, aType);
+    auto b = g->addTensor({k, n}, DataType::Int8);
+    auto bScale = g->addTensor({n}, DataType::Float32);
+    auto bZero = g->addTensor({n}, DataType::Int8);
+    auto yScale = g->addTensor({1}, DataType::Float32);
+    auto yZero = g->addTensor({1}, DataType::Int8);
+    auto dqA = g->addOp<DequantizeLinearObj>(a, aScale, aZero, nullptr, 1);
+    auto dqB = g->addOp<DequantizeLinearObj>(b, bScale, bZero, nullptr, 1);
+    auto mm = g->addOp<MatmulObj>(dqA->getOutput(), dqB->getOutput(), nullptr);
+    auto q = g->addOp<QuantizeLinearObj>(mm->getOutput(), yScale, yZero,
+                                         nullptr, 1);
+    if (optimize) {
+        g->optimize();
+        EXPECT_EQ(g->getOperators().size(), 1);
+        EXPECT_EQ(g->getOperators()[0]->getOpType(), OpType::QLinearMatMul);
+    }
+    g->dataMalloc();
+
+    vector<TA> aData(m * k);
+    for (int i = 0; i < m * k; ++i)
+        aData[i] = TA(i * 7 % 255 - (std::is_signed_v<TA> ? 127 : 0));
+    copyIn(a, aData);
+    copyIn<float>(aScale, {0.5f});
+    copyIn<TA>(aZero, {TA(3)});
+    copyIn(b, quantizedWeights(bSeed));
+    copyIn<float>(bScale, {0.25f, 0.5f, 0.125f, 1.f, 0.25f});
+    copyIn<int8_t>(bZero, {0, -2, 5, 1, 7});
+    copyIn<float>(yScale, {512.f});
+    copyIn<int8_t>(yZero, {-5});
+
+    runtime->run(g);
+    return {g, q->getOutput()};
+}
+
+TEST(QLinearMatMul, FoldedMatchesFloatPath) {
+    auto ref = runQuantizedMatmul<int8_t>(false, DataType::Int8);
+    auto fused = runQuantizedMatmul<int8_t>(true, DataType::Int8);
+    EXPECT_TRUE(fused.second->equalData(ref.second));
+
+    auto refU8 = runQuantizedMatmul<uint8_t>(false, DataType::UInt8);
+    auto fusedU8 = runQuantizedMatmul<uint8_t>(true, DataType::UInt8);
+    EXPECT_TRUE(fusedU8.second->equalData(refU8.second));
+}
+
+TEST(QLinearMatMul, PackedWeightsReused) {
+    auto [g, y] = runQuantizedMatmul<int8_t>(true, DataType::Int8);
+    auto op = as<QLinearMatMulObj>(g->getOperators()[0]);
+    auto packed = op->getPackedWeights();
+    ASSERT_NE(packed, nullptr);
+    vector<int8_t> first(y->getRawDataPtr<int8_t *>(),
+                         y->getRawDataPtr<int8_t *>() + y->size());
+    g->getRuntime()->run(g);
+    EXPECT_EQ(op->getPackedWeights(), packed);
+    EXPECT_TRUE(y->equalData(first));
+
+    // B overwritten in place is only seen after a reset
+    copyIn(op->getInputs(3), quantizedWeights(29));
+    op->resetPackedWeights();
+    g->getRuntime()->run(g);
+    EXPECT_NE(op->getPackedWeights(), packed);
+    auto ref = runQuantizedMatmul<int8_t>(false, DataType::Int8, 29);
+    EXPECT_TRUE(y->equalData(ref.second));
+}
+
+} // namespace infini
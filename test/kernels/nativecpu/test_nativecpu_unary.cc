@@ -0,0 +1,119 @@
+#include "core/graph.h"
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+#include "utils/float16.h"
+
+#include "test.h"
+#include <cmath>
+
+namespace infini {
+
+// Distance from a float result to the double reference, in units of the
+// reference's float ulp (denormal spacing below FLT_MIN)
+static double ulpError(float value, double ref) {
+    if (std::isnan(ref))
+        return std::isnan(value) ? 0 : INFINITY;
+    if (std::isinf(float(ref)) || std::isinf(value))
+        return value == float(ref) ? 0 : INFINITY;
+    int exp;
+    std::frexp(ref, &exp);
+    return std::fabs(value - ref) / std::ldexp(1.0, std::max(exp - 24, -149));
+}
+
+template <typename T>
+void testActivation(double (*ref)(double), float lo, float hi,
+                    double maxUlp) {
+    // Dense sweep plus the special values, 1 + 8k + 3 elements so that the
+    // padded tail is covered too
+    vector<float> input;
+    const int n = 1 << 16;
+    for (int i = 0; i <= n; ++i)
+        input.emplace_back(lo + (hi - lo) * i / n);
+    for (float v : {0.f, -0.f, 1e-30f, -1e-30f, INFINITY, -INFINITY, NAN,
+                    200.f, -200.f, 0.625f, -0.625f})
+        input.emplace_back(v);
+
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({(int)input.size()}, DataType::Float32);
+    auto op = g->addOp<T>(x, nullptr);
+    g->dataMalloc();
+    auto y = op->getOutput()->template getRawDataPtr<float *>();
+
+    auto &candidates = KernelRegistry::getInstance().getKernelCandidates(
+        getKernelAttrs(Device::CPU, op));
+    ASSERT_EQ(candidates.size(), 2u);
+    // The fast kernel is the default
+    EXPECT_NE(std::get<1>(candidates[0]).find("Fast"), string::npos);
+    for (auto &record : candidates) {
+        op->setKernel(std::get<0>(record));
+        x->setData([&](void *ptr, size_t size, DataType) {
+            std::memcpy(ptr, input.data(), size * sizeof(float));
+        });
+        runtime->run(g);
+        const bool exact = std::get<1>(record).find("Exact") != string::npos;
+        for (size_t i = 0; i < input.size(); ++i) {
+            double err = ulpError(y[i], ref(input[i]));
+            EXPECT_LE(err, exact ? 0.501 : maxUlp)
+                << std::get<1>(record) << " at " << input[i] << ": " << y[i];
+        }
+    }
+}
+
+TEST(Unary, Activations) {
+    testActivation<ExpObj>([](double x) { return std::exp(x); }, -104.f,
+                           89.f, 1);
+    testActivation<SigmoidObj>(
+        [](double x) { return 1 / (1 + std::exp(-x)); }, -110.f, 90.f, 3);
+    testActivation<SiluObj>(
+        [](double x) { return x < -745 ? -0. : x / (1 + std::exp(-x)); },
+        -125.f, 90.f, 4);
+    testActivation<TanhObj>([](double x) { return std::tanh(x); }, -10.f,
+                            10.f, 2);
+    testActivation<GeluObj>(
+        [](double x) {
+            return x < -40 ? -0. : 0.5 * x * std::erfc(-x * M_SQRT1_2);
+        },
+        -16.f,
+        12.f, 8);
+}
+
+TEST(Unary, ExactActivationNotTuned) {
+    // The exact reference computes other results, so a tuner always keeps
+    // the fast default whatever the timings
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({1 << 12}, DataType::Float32);
+    auto op = g->addOp<GeluObj>(x, nullptr);
+    g->setKernelTuner(make_ref<KernelTuner>());
+    g->dataMalloc();
+    auto &candidates = KernelRegistry::getInstance().getKernelCandidates(
+        getKernelAttrs(Device::CPU, op));
+    ASSERT_EQ(candidates.size(), 2u);
+    EXPECT_FALSE(std::get<0>(candidates[1])->isTunable());
+    EXPECT_EQ(op->getKernel(), std::get<0>(candidates[0]));
+}
+
+TEST(Unary, ActivationFloat16) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({2, 2}, DataType::Float16);
+    auto op = g->addOp<SigmoidObj>(x, nullptr);
+    EXPECT_EQ(op->getOutput()->getDims(), (Shape{2, 2}));
+    EXPECT_EQ(op->getOutput()->getDType(), DataType::Float16);
+    g->dataMalloc();
+    vector<uint16_t> in;
+    for (float v : {0.f, 2.f, -2.f, 20.f})
+        in.emplace_back(fp32_to_fp16(v));
+    x->setData([&](void *ptr, size_t size, DataType) {
+        std::memcpy(ptr, in.data(), size * sizeof(uint16_t));
+    });
+    runtime->run(g);
+    vector<uint16_t> ans;
+    for (float v : {0.5f, 0.880797f, 0.119203f, 1.f})
+        ans.emplace_back(fp32_to_fp16(v));
+    EXPECT_TRUE(op->getOutput()->equalData(ans));
+}
+
+} // namespace infini
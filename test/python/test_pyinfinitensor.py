@@ -0,0 +1,64 @@
+import sys
+import unittest
+
+try:
+    import numpy as np
+except ImportError:
+    print("numpy is not installed, skipping")
+    sys.exit(77)
+
+import pyinfinitensor as it
+
+
+class TestPyInfiniTensor(unittest.TestCase):
+    def test_view_round_trip(self):
+        g = it.Graph()
+        x = g.tensor([2, 3])
+        y = g.relu(x)
+        g.data_malloc()
+        self.assertEqual(x.shape, (2, 3))
+        self.assertEqual(x.dtype, "float32")
+        np.asarray(x)[:] = np.array([[-1, 2, -3], [4, -5, 6]], np.float32)
+        # A second view sees the data written through the first one
+        np.testing.assert_array_equal(
+            np.asarray(x), [[-1, 2, -3], [4, -5, 6]])
+        g.run()
+        np.testing.assert_array_equal(np.asarray(y), [[0, 2, 0], [4, 0, 6]])
+
+    def test_bind(self):
+        g = it.Graph()
+        a = g.tensor([2, 2])
+        b = g.tensor([2, 2])
+        c = g.add(a, b)
+        g.data_malloc()
+        av = np.array([[1, 2], [3, 4]], np.float32)
+        bv = np.full((2, 2), 10, np.float32)
+        cv = np.zeros((2, 2), np.float32)
+        g.bind(a, av)
+        g.bind(b, bv)
+        g.bind(c, cv)
+        g.run()
+        np.testing.assert_array_equal(cv, [[11, 12], [13, 14]])
+        # The bound arrays are used in place, no copy is taken
+        av[0, 0] = 5
+        g.run()
+        self.assertEqual(cv[0, 0], 15)
+        with self.assertRaises(ValueError):
+            g.bind(a, np.zeros(3, np.float32))
+
+    def test_replan_with_live_view(self):
+        g = it.Graph()
+        x = g.tensor([4])
+        g.relu(x)
+        g.data_malloc()
+        view = np.asarray(x)
+        with self.assertRaises(BufferError):
+            g.data_malloc()
+        with self.assertRaises(BufferError):
+            g.optimize()
+        del view
+        g.data_malloc()
+
+
+if __name__ == "__main__":
+    unittest.main()